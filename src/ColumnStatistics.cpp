@@ -0,0 +1,29 @@
+#include "ColumnStatistics.h"
+
+bool ColumnStatistics::hasFiniteValues() const
+{
+    return _numberOfFiniteValues > 0;
+}
+
+std::uint64_t ColumnStatistics::getNumberOfNonFiniteValues() const
+{
+    return _numberOfNaNs + _numberOfInfinities;
+}
+
+double ColumnStatistics::getMean() const
+{
+    return _numberOfFiniteValues > 0 ? _sum / static_cast<double>(_numberOfFiniteValues) : 0.0;
+}
+
+void ColumnStatistics::merge(const ColumnStatistics& other)
+{
+    _minimum                = std::min(_minimum, other._minimum);
+    _maximum                = std::max(_maximum, other._maximum);
+    _sum                   += other._sum;
+    _numberOfFiniteValues  += other._numberOfFiniteValues;
+    _numberOfNaNs          += other._numberOfNaNs;
+    _numberOfInfinities    += other._numberOfInfinities;
+
+    // The percentiles of the parts do not determine those of the merged column
+    _percentiles.clear();
+}
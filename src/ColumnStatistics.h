@@ -0,0 +1,217 @@
+#pragma once
+
+#include "ParallelUtils.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+/**
+ * Column statistics
+ *
+ * Range, sum and counts of a column of values. Non-finite values (NaN and infinities) are counted
+ * separately and do not contribute to the range and the sum, so that callers can report them
+ * instead of having them silently expand the range. Percentiles are only filled on request (see
+ * computeColumnPercentiles), they can not be merged.
+ */
+struct ColumnStatistics {
+    float               _minimum                = std::numeric_limits<float>::max();        /** Minimum of the finite values */
+    float               _maximum                = std::numeric_limits<float>::lowest();     /** Maximum of the finite values */
+    double              _sum                    = 0.0;                                      /** Sum of the finite values */
+    std::uint64_t       _numberOfFiniteValues   = 0;                                        /** Number of finite values */
+    std::uint64_t       _numberOfNaNs           = 0;                                        /** Number of NaN values */
+    std::uint64_t       _numberOfInfinities     = 0;                                        /** Number of (positive or negative) infinite values */
+    std::vector<float>  _percentiles;                                                       /** Percentiles COLUMN_PERCENTILES of the finite values (empty when not computed or without finite values) */
+
+    /** Determines whether the column contains finite values (only then the range is valid) */
+    bool hasFiniteValues() const;
+
+    /** Get the number of NaN and infinite values */
+    std::uint64_t getNumberOfNonFiniteValues() const;
+
+    /** Get the mean of the finite values (zero when there are none) */
+    double getMean() const;
+
+    /**
+     * Merge with the statistics of another part of the column
+     * @param other Statistics of the other part
+     */
+    void merge(const ColumnStatistics& other);
+};
+
+// Values per chunk below which column statistics are computed on the calling thread
+constexpr std::size_t COLUMN_STATISTICS_MINIMUM_CHUNK_SIZE = 65536;
+
+// Percentiles (in ascending order) computed by computeColumnPercentiles, e.g. for robust ranges
+constexpr std::array<float, 5> COLUMN_PERCENTILES = { 1.0f, 5.0f, 50.0f, 95.0f, 99.0f };
+
+// Number of histogram bins over the range of a column from which its percentiles are interpolated
+constexpr std::size_t COLUMN_PERCENTILES_NUMBER_OF_BINS = 4096;
+
+/*  Computes the statistics of the count values getValue(0), getValue(1), ..., getValue(count - 1) (convertible to float), e.g.
+        const auto statistics = computeColumnStatistics(numberOfPoints, [&](std::size_t pointIndex) -> float { return pointData[pointIndex][dimensionIndex]; });
+    The range is split into chunks over the global thread pool. The loop body is branch-free (a value is
+    finite when subtracting it from itself yields zero), so that the compiler can vectorize it for inlined accessors.
+*/
+template<typename GetValue>
+ColumnStatistics computeColumnStatistics(std::size_t count, GetValue getValue) {
+    constexpr std::size_t LANES         = 8;
+    constexpr std::size_t BLOCK_SIZE    = 4096;
+
+    const auto numberOfChunks = getNumberOfChunks(count, COLUMN_STATISTICS_MINIMUM_CHUNK_SIZE);
+
+    std::vector<ColumnStatistics> chunkStatistics(numberOfChunks);
+
+    forEachChunk(count, numberOfChunks, [&chunkStatistics, &getValue](std::size_t chunkIndex, std::size_t begin, std::size_t end) -> void {
+        // Independent accumulators per lane, so that consecutive values do not wait on each other
+        float           minimum[LANES], maximum[LANES], sum[LANES];
+        std::uint32_t   numberOfFiniteValues[LANES], numberOfNaNs[LANES];
+
+        for (std::size_t lane = 0; lane < LANES; lane++) {
+            minimum[lane]               = std::numeric_limits<float>::max();
+            maximum[lane]               = std::numeric_limits<float>::lowest();
+            sum[lane]                   = 0.0f;
+            numberOfFiniteValues[lane]  = 0;
+            numberOfNaNs[lane]          = 0;
+        }
+
+        ColumnStatistics chunk;
+
+        // Sums and counts are flushed to the chunk statistics per block, which bounds the single precision error
+        for (std::size_t blockBegin = begin; blockBegin < end; blockBegin += BLOCK_SIZE) {
+            const auto blockEnd = std::min(end, blockBegin + BLOCK_SIZE);
+
+            auto index = blockBegin;
+
+            for (; index + LANES <= blockEnd; index += LANES) {
+                for (std::size_t lane = 0; lane < LANES; lane++) {
+                    const auto value    = static_cast<float>(getValue(index + lane));
+                    const auto isFinite = value - value == 0.0f;
+
+                    minimum[lane]   = isFinite ? std::min(minimum[lane], value) : minimum[lane];
+                    maximum[lane]   = isFinite ? std::max(maximum[lane], value) : maximum[lane];
+                    sum[lane]      += isFinite ? value : 0.0f;
+
+                    numberOfFiniteValues[lane]  += isFinite;
+                    numberOfNaNs[lane]          += value != value;
+                }
+            }
+
+            for (; index < blockEnd; index++) {
+                const auto value    = static_cast<float>(getValue(index));
+                const auto isFinite = value - value == 0.0f;
+
+                minimum[0]  = isFinite ? std::min(minimum[0], value) : minimum[0];
+                maximum[0]  = isFinite ? std::max(maximum[0], value) : maximum[0];
+                sum[0]     += isFinite ? value : 0.0f;
+
+                numberOfFiniteValues[0] += isFinite;
+                numberOfNaNs[0]         += value != value;
+            }
+
+            for (std::size_t lane = 0; lane < LANES; lane++) {
+                chunk._sum                  += sum[lane];
+                chunk._numberOfFiniteValues += numberOfFiniteValues[lane];
+                chunk._numberOfNaNs         += numberOfNaNs[lane];
+
+                sum[lane]                   = 0.0f;
+                numberOfFiniteValues[lane]  = 0;
+                numberOfNaNs[lane]          = 0;
+            }
+        }
+
+        for (std::size_t lane = 0; lane < LANES; lane++) {
+            chunk._minimum = std::min(chunk._minimum, minimum[lane]);
+            chunk._maximum = std::max(chunk._maximum, maximum[lane]);
+        }
+
+        chunk._numberOfInfinities = (end - begin) - chunk._numberOfFiniteValues - chunk._numberOfNaNs;
+
+        chunkStatistics[chunkIndex] = chunk;
+    });
+
+    ColumnStatistics statistics;
+
+    for (const auto& chunk : chunkStatistics)
+        statistics.merge(chunk);
+
+    return statistics;
+}
+
+// Computes the statistics of the count values at values[0], values[stride], values[2 * stride], ... (e.g. one dimension of row-major point data)
+template<typename Value>
+ColumnStatistics computeColumnStatistics(const Value* values, std::size_t count, std::size_t stride = 1) {
+    return computeColumnStatistics(count, [values, stride](std::size_t index) -> Value {
+        return values[index * stride];
+    });
+}
+
+/*  Computes COLUMN_PERCENTILES of the finite values getValue(0), getValue(1), ..., getValue(count - 1), given their statistics (range
+    and number of finite values), e.g.
+        statistics._percentiles = computeColumnPercentiles(numberOfPoints, getValue, statistics);
+    The values are binned over the range in a second pass (split into chunks over the global thread pool) and the percentiles are
+    interpolated within their bins, so they are accurate to the range divided by COLUMN_PERCENTILES_NUMBER_OF_BINS. Returns no
+    percentiles when there are no finite values.
+*/
+template<typename GetValue>
+std::vector<float> computeColumnPercentiles(std::size_t count, GetValue getValue, const ColumnStatistics& statistics) {
+    if (!statistics.hasFiniteValues())
+        return {};
+
+    if (statistics._maximum <= statistics._minimum)
+        return std::vector<float>(COLUMN_PERCENTILES.size(), statistics._minimum);
+
+    const auto minimum      = statistics._minimum;
+    const auto binWidth     = (statistics._maximum - statistics._minimum) / static_cast<float>(COLUMN_PERCENTILES_NUMBER_OF_BINS);
+    const auto binScale     = 1.0f / binWidth;
+    const auto lastBin      = static_cast<float>(COLUMN_PERCENTILES_NUMBER_OF_BINS - 1);
+
+    const auto numberOfChunks = getNumberOfChunks(count, COLUMN_STATISTICS_MINIMUM_CHUNK_SIZE);
+
+    std::vector<std::uint64_t> chunkHistograms(numberOfChunks * COLUMN_PERCENTILES_NUMBER_OF_BINS, 0);
+
+    forEachChunk(count, numberOfChunks, [&chunkHistograms, &getValue, minimum, binScale, lastBin](std::size_t chunkIndex, std::size_t begin, std::size_t end) -> void {
+        const auto histogram = chunkHistograms.data() + chunkIndex * COLUMN_PERCENTILES_NUMBER_OF_BINS;
+
+        for (std::size_t index = begin; index < end; index++) {
+            const auto value = static_cast<float>(getValue(index));
+
+            if (value - value != 0.0f)
+                continue;
+
+            histogram[static_cast<std::size_t>(std::min(lastBin, std::max(0.0f, (value - minimum) * binScale)))]++;
+        }
+    });
+
+    std::vector<std::uint64_t> histogram(COLUMN_PERCENTILES_NUMBER_OF_BINS, 0);
+
+    for (std::size_t chunkIndex = 0; chunkIndex < numberOfChunks; chunkIndex++)
+        for (std::size_t binIndex = 0; binIndex < COLUMN_PERCENTILES_NUMBER_OF_BINS; binIndex++)
+            histogram[binIndex] += chunkHistograms[chunkIndex * COLUMN_PERCENTILES_NUMBER_OF_BINS + binIndex];
+
+    std::vector<float> percentiles;
+
+    percentiles.reserve(COLUMN_PERCENTILES.size());
+
+    std::size_t     binIndex                = 0;
+    std::uint64_t   numberOfValuesBelowBin  = 0;
+
+    // Walk the cumulative histogram up to the bin which holds the rank of each percentile (the percentiles are ascending)
+    for (const auto percentile : COLUMN_PERCENTILES) {
+        const auto rank = static_cast<double>(percentile) / 100.0 * static_cast<double>(statistics._numberOfFiniteValues - 1);
+
+        while (binIndex + 1 < COLUMN_PERCENTILES_NUMBER_OF_BINS && static_cast<double>(numberOfValuesBelowBin + histogram[binIndex]) <= rank) {
+            numberOfValuesBelowBin += histogram[binIndex];
+            binIndex++;
+        }
+
+        const auto fractionInBin = histogram[binIndex] > 0 ? (rank - static_cast<double>(numberOfValuesBelowBin) + 0.5) / static_cast<double>(histogram[binIndex]) : 0.5;
+
+        percentiles.push_back(std::min(statistics._maximum, std::max(statistics._minimum, minimum + (static_cast<float>(binIndex) + static_cast<float>(fractionInBin)) * binWidth)));
+    }
+
+    return percentiles;
+}
@@ -0,0 +1,102 @@
+#include "ColumnStatisticsCache.h"
+#include "ColumnView.h"
+
+#include <QMetaObject>
+
+#include <utility>
+
+using namespace mv;
+
+ColumnStatisticsCache::ColumnStatisticsCache(QObject* parent) :
+    QObject(parent),
+    _entries(),
+    _droppedEntries()
+{
+}
+
+ColumnStatistics ColumnStatisticsCache::getStatistics(const Dataset<Points>& points, std::int32_t dimensionIndex)
+{
+    if (!points.isValid())
+        return {};
+
+    const auto datasetId = points->getId();
+
+    auto& entry = _entries[datasetId];
+
+    if (!entry) {
+        entry = std::make_unique<Entry>();
+
+        entry->_dataset = points;
+
+        // The entry is kept (only its statistics are dropped), so that the watched dataset is not destroyed while it emits
+        connect(&entry->_dataset, &Dataset<Points>::dataChanged, this, [this, datasetId]() -> void {
+            invalidate(datasetId);
+        });
+
+        connect(&entry->_dataset, &Dataset<Points>::aboutToBeRemoved, this, [this, datasetId]() -> void {
+            remove(datasetId);
+        });
+    }
+
+    // Safeguard against data changes which were not (yet) signalled
+    if (entry->_numberOfPoints != points->getNumPoints()) {
+        entry->_dimensions.clear();
+        entry->_numberOfPoints = points->getNumPoints();
+    }
+
+    const auto it = entry->_dimensions.find(dimensionIndex);
+
+    if (it != entry->_dimensions.end())
+        return it->second;
+
+    const auto statistics = computeStatistics(points, dimensionIndex);
+
+    entry->_dimensions[dimensionIndex] = statistics;
+
+    return statistics;
+}
+
+ColumnStatistics ColumnStatisticsCache::computeStatistics(const Dataset<Points>& points, std::int32_t dimensionIndex)
+{
+    ColumnStatistics statistics;
+
+    if (!points.isValid() || dimensionIndex < 0 || static_cast<std::uint32_t>(dimensionIndex) >= points->getNumDimensions())
+        return statistics;
+
+    visitColumn(*points, dimensionIndex, [&statistics](const auto& column) -> void {
+        const auto getValue = [&column](std::size_t pointIndex) -> float {
+            return static_cast<float>(column[pointIndex]);
+        };
+
+        statistics              = computeColumnStatistics(column.size(), getValue);
+        statistics._percentiles = computeColumnPercentiles(column.size(), getValue, statistics);
+    });
+
+    return statistics;
+}
+
+void ColumnStatisticsCache::invalidate(const QString& datasetId)
+{
+    const auto it = _entries.find(datasetId);
+
+    if (it != _entries.end())
+        it->second->_dimensions.clear();
+}
+
+void ColumnStatisticsCache::remove(const QString& datasetId)
+{
+    const auto it = _entries.find(datasetId);
+
+    if (it == _entries.end())
+        return;
+
+    _droppedEntries.push_back(std::move(it->second));
+
+    _entries.erase(it);
+
+    if (_droppedEntries.size() == 1) {
+        QMetaObject::invokeMethod(this, [this]() -> void {
+            _droppedEntries.clear();
+        }, Qt::QueuedConnection);
+    }
+}
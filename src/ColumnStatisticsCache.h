@@ -0,0 +1,75 @@
+#pragma once
+
+#include "ColumnStatistics.h"
+
+#include <Dataset.h>
+#include <PointData/PointData.h>
+
+#include <QObject>
+#include <QString>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+
+/**
+ * Column statistics cache class
+ *
+ * Caches the statistics (including percentiles) of points dataset dimensions, keyed by dataset
+ * identifier and dimension index, so that re-picking a dimension does not rescan its column. The
+ * statistics of a dataset are dropped when its data changes, and its entry when it is about to be
+ * removed.
+ */
+class ColumnStatisticsCache : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    /**
+     * Construct with \p parent object
+     * @param parent Pointer to parent object
+     */
+    ColumnStatisticsCache(QObject* parent = nullptr);
+
+    /**
+     * Get the statistics of dimension \p dimensionIndex of \p points (computed on first request)
+     * @param points Smart pointer to the points dataset
+     * @param dimensionIndex Dimension index
+     * @return Column statistics with percentiles (without finite values for an invalid dataset or dimension)
+     */
+    ColumnStatistics getStatistics(const mv::Dataset<Points>& points, std::int32_t dimensionIndex);
+
+    /**
+     * Compute the statistics of dimension \p dimensionIndex of \p points (without caching)
+     * @param points Smart pointer to the points dataset
+     * @param dimensionIndex Dimension index
+     * @return Column statistics with percentiles (without finite values for an invalid dataset or dimension)
+     */
+    static ColumnStatistics computeStatistics(const mv::Dataset<Points>& points, std::int32_t dimensionIndex);
+
+    /**
+     * Drop the statistics of the dataset with \p datasetId
+     * @param datasetId Globally unique identifier of the dataset
+     */
+    void invalidate(const QString& datasetId);
+
+    /**
+     * Drop the entry of the dataset with \p datasetId (which stops watching the dataset)
+     * @param datasetId Globally unique identifier of the dataset
+     */
+    void remove(const QString& datasetId);
+
+private:
+
+    /** Cached statistics of a dataset */
+    struct Entry {
+        mv::Dataset<Points>                         _dataset;               /** Smart pointer to the dataset (watched for data changes) */
+        std::uint32_t                               _numberOfPoints = 0;    /** Number of points at the time the statistics were computed */
+        std::map<std::int32_t, ColumnStatistics>    _dimensions;            /** Statistics per dimension index */
+    };
+
+    std::map<QString, std::unique_ptr<Entry>>   _entries;           /** Cached statistics per dataset identifier */
+    std::vector<std::unique_ptr<Entry>>         _droppedEntries;    /** Dropped entries, released once control returns to the event loop (their datasets may be emitting) */
+};
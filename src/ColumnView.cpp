@@ -0,0 +1,24 @@
+#include "ColumnView.h"
+#include "ParallelUtils.h"
+
+bool extractColumns(const Points& points, const std::vector<std::int32_t>& dimensionIndices, std::vector<std::vector<float>>& values)
+{
+    values.resize(dimensionIndices.size());
+
+    for (auto& columnValues : values)
+        columnValues.clear();
+
+    return visitColumns(points, dimensionIndices, [&values](const auto& columns) -> void {
+        const auto count = columns.empty() ? 0 : columns.front().size();
+
+        for (auto& columnValues : values)
+            columnValues.resize(count);
+
+        // Each chunk reads all requested dimensions of a row before moving on to the next row
+        forEachChunk(count, getNumberOfChunks(count, COLUMN_EXTRACTION_MINIMUM_CHUNK_SIZE), [&values, &columns](std::size_t chunkIndex, std::size_t begin, std::size_t end) -> void {
+            for (std::size_t pointIndex = begin; pointIndex < end; pointIndex++)
+                for (std::size_t columnIndex = 0; columnIndex < columns.size(); columnIndex++)
+                    values[columnIndex][pointIndex] = static_cast<float>(columns[columnIndex][pointIndex]);
+        });
+    });
+}
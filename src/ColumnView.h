@@ -0,0 +1,175 @@
+#pragma once
+
+#include <PointData/PointData.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Column view class
+ *
+ * Typed read-only view on one dimension of row-major point data (pointer, stride and count), so
+ * that loops over a dimension compile to tight (vectorizable) loops for each storage type.
+ */
+template<typename Value>
+class ColumnView
+{
+public:
+
+    /**
+     * Construct with \p data, \p count and \p stride
+     * @param data Pointer to the value of the first point
+     * @param count Number of points
+     * @param stride Number of values between consecutive points (the number of dimensions)
+     */
+    ColumnView(const Value* data, std::size_t count, std::size_t stride) :
+        _data(data),
+        _count(count),
+        _stride(stride)
+    {
+    }
+
+    /** Get the number of points */
+    std::size_t size() const {
+        return _count;
+    }
+
+    /** Get the value of the point at \p index */
+    const Value& operator[](std::size_t index) const {
+        return _data[index * _stride];
+    }
+
+private:
+    const Value*    _data;      /** Pointer to the value of the first point */
+    std::size_t     _count;     /** Number of points */
+    std::size_t     _stride;    /** Number of values between consecutive points */
+};
+
+/**
+ * Indirect column view class
+ *
+ * Column view on the point data accessor of Points::visitData, used for datasets which are not
+ * stored contiguously (e.g. subsets), where points are looked up through their indices.
+ */
+template<typename PointData>
+class IndirectColumnView
+{
+public:
+
+    /**
+     * Construct with \p pointData, \p dimensionIndex and \p count
+     * @param pointData Point data accessor
+     * @param dimensionIndex Dimension index
+     * @param count Number of points
+     */
+    IndirectColumnView(PointData& pointData, std::uint32_t dimensionIndex, std::size_t count) :
+        _pointData(pointData),
+        _dimensionIndex(dimensionIndex),
+        _count(count)
+    {
+    }
+
+    /** Get the number of points */
+    std::size_t size() const {
+        return _count;
+    }
+
+    /** Get the value of the point at \p index */
+    auto operator[](std::size_t index) const {
+        return _pointData[index][_dimensionIndex];
+    }
+
+private:
+    PointData&      _pointData;         /** Point data accessor */
+    std::uint32_t   _dimensionIndex;    /** Dimension index */
+    std::size_t     _count;             /** Number of points */
+};
+
+/*  Invokes function(column) with a view on dimension dimensionIndex of points, e.g.
+        visitColumn(points, dimensionIndex, [&](const auto& column) -> void {
+            for (std::size_t pointIndex = 0; pointIndex < column.size(); pointIndex++)
+                values[pointIndex] = static_cast<float>(column[pointIndex]);
+        });
+    The function is instantiated for each storage type (float, bfloat16, integer types). Contiguously stored datasets
+    are visited through a ColumnView on their storage, other datasets through an IndirectColumnView.
+    Returns false (without invoking function) when dimensionIndex is out of range.
+*/
+template<typename Function>
+bool visitColumn(const Points& points, std::int32_t dimensionIndex, Function function) {
+    const auto numberOfPoints       = static_cast<std::size_t>(points.getNumPoints());
+    const auto numberOfDimensions   = static_cast<std::size_t>(points.getNumDimensions());
+
+    if (dimensionIndex < 0 || static_cast<std::size_t>(dimensionIndex) >= numberOfDimensions)
+        return false;
+
+    if (points.isFull()) {
+        points.visitFromBeginToEnd([&function, dimensionIndex, numberOfPoints, numberOfDimensions](auto begin, auto end) -> void {
+            using Value = std::remove_cv_t<std::remove_reference_t<decltype(*begin)>>;
+
+            const auto count = std::min(numberOfPoints, static_cast<std::size_t>(end - begin) / numberOfDimensions);
+
+            function(ColumnView<Value>(count > 0 ? &*begin + dimensionIndex : nullptr, count, numberOfDimensions));
+        });
+    }
+    else {
+        points.visitData([&function, dimensionIndex, numberOfPoints](auto pointData) -> void {
+            function(IndirectColumnView<decltype(pointData)>(pointData, static_cast<std::uint32_t>(dimensionIndex), numberOfPoints));
+        });
+    }
+
+    return true;
+}
+
+/*  Invokes function(columns) with a vector of views on the dimensions dimensionIndices of points, all of the same view type (see
+    visitColumn), so that several dimensions can be read in a single pass over the rows.
+    Returns false (without invoking function) when any of the dimension indices is out of range.
+*/
+template<typename Function>
+bool visitColumns(const Points& points, const std::vector<std::int32_t>& dimensionIndices, Function function) {
+    const auto numberOfPoints       = static_cast<std::size_t>(points.getNumPoints());
+    const auto numberOfDimensions   = static_cast<std::size_t>(points.getNumDimensions());
+
+    for (const auto dimensionIndex : dimensionIndices)
+        if (dimensionIndex < 0 || static_cast<std::size_t>(dimensionIndex) >= numberOfDimensions)
+            return false;
+
+    if (points.isFull()) {
+        points.visitFromBeginToEnd([&function, &dimensionIndices, numberOfPoints, numberOfDimensions](auto begin, auto end) -> void {
+            using Value = std::remove_cv_t<std::remove_reference_t<decltype(*begin)>>;
+
+            const auto count = std::min(numberOfPoints, static_cast<std::size_t>(end - begin) / numberOfDimensions);
+
+            std::vector<ColumnView<Value>> columns;
+
+            columns.reserve(dimensionIndices.size());
+
+            for (const auto dimensionIndex : dimensionIndices)
+                columns.emplace_back(count > 0 ? &*begin + dimensionIndex : nullptr, count, numberOfDimensions);
+
+            function(columns);
+        });
+    }
+    else {
+        points.visitData([&function, &dimensionIndices, numberOfPoints](auto pointData) -> void {
+            std::vector<IndirectColumnView<decltype(pointData)>> columns;
+
+            columns.reserve(dimensionIndices.size());
+
+            for (const auto dimensionIndex : dimensionIndices)
+                columns.emplace_back(pointData, static_cast<std::uint32_t>(dimensionIndex), numberOfPoints);
+
+            function(columns);
+        });
+    }
+
+    return true;
+}
+
+// Minimum number of values copied by a single thread in extractColumns
+constexpr std::size_t COLUMN_EXTRACTION_MINIMUM_CHUNK_SIZE = 65536;
+
+// Copies the dimensions dimensionIndices of points into values (one vector per dimension) in a single pass over the rows, returns false when any dimension index is out of range
+bool extractColumns(const Points& points, const std::vector<std::int32_t>& dimensionIndices, std::vector<std::vector<float>>& values);
@@ -3,6 +3,9 @@
 #include "ScatterplotPlugin.h"
 #include "ScatterplotWidget.h"
 
+#include <algorithm>
+#include <limits>
+
 const QMap<ExportAction::Scale, TriggersAction::Trigger> ExportAction::triggers = QMap<ExportAction::Scale, TriggersAction::Trigger>({
     { ExportAction::Eighth, TriggersAction::Trigger("12.5%", "Scale by 1/8th") },
     { ExportAction::Quarter, TriggersAction::Trigger("25%", "Scale by a quarter") },
@@ -140,6 +143,11 @@ void ExportAction::initialize(ScatterplotPlugin* scatterplotPlugin)
 
     connect(&_overrideRangesAction, &ToggleAction::toggled, this, updateFixedRangeReadOnly);
 
+    connect(&_overrideRangesAction, &ToggleAction::toggled, this, [this](bool toggled) -> void {
+        if (toggled && !mv::projects().isOpeningProject())
+            initializeFixedRange();
+    });
+
     connect(&_fileNamePrefixAction, &StringAction::stringChanged, this, &ExportAction::updateExportTrigger);
     connect(&_outputDirectoryAction, &DirectoryPickerAction::directoryChanged, this, &ExportAction::updateExportTrigger);
 
@@ -163,6 +171,41 @@ void ExportAction::initializeTargetSize()
     _aspectRatio = static_cast<float>(_targetHeightAction.getValue()) / static_cast<float>(_targetWidthAction.getValue());
 }
 
+void ExportAction::initializeFixedRange()
+{
+    const auto& positionDataset = _scatterplotPlugin->getPositionDataset();
+
+    if (!positionDataset.isValid())
+        return;
+
+    const auto enabledDimensions = _dimensionSelectionAction.getEnabledDimensions();
+
+    ColumnStatistics    limits;
+    float               minimum = std::numeric_limits<float>::max();
+    float               maximum = std::numeric_limits<float>::lowest();
+
+    // Span the percentile ranges of the dimensions to export
+    for (std::int32_t dimensionIndex = 0; dimensionIndex < static_cast<std::int32_t>(enabledDimensions.size()); dimensionIndex++) {
+        if (!enabledDimensions[dimensionIndex])
+            continue;
+
+        const auto statistics = _scatterplotPlugin->getColumnStatisticsCache().getStatistics(positionDataset, dimensionIndex);
+
+        if (!statistics.hasFiniteValues() || statistics._percentiles.empty())
+            continue;
+
+        limits.merge(statistics);
+
+        minimum = std::min(minimum, statistics._percentiles.front());
+        maximum = std::max(maximum, statistics._percentiles.back());
+    }
+
+    if (!limits.hasFiniteValues())
+        return;
+
+    _fixedRangeAction.initialize({ limits._minimum, limits._maximum }, { minimum, maximum });
+}
+
 void ExportAction::exportImages()
 {
     auto& coloringAction = _scatterplotPlugin->getSettingsAction().getColoringAction();
@@ -62,6 +62,9 @@ public:
     /** Grab target size from scatter plot widget */
     void initializeTargetSize();
 
+    /** Initialize the fixed range from the 1st to the 99th percentile of the dimensions to export (limited to their range) */
+    void initializeFixedRange();
+
     /** Export images to disk */
     void exportImages();
 
@@ -0,0 +1,116 @@
+#include "IncrementalSelection.h"
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+
+void IncrementalSelection::begin(std::uint32_t numberOfPoints)
+{
+    _active                 = true;
+    _numberOfPoints         = numberOfPoints;
+    _numberOfSelectedPoints = 0;
+
+    _isSelected.assign((static_cast<std::size_t>(numberOfPoints) + 63) / 64, 0);
+
+    _selectionMask.reset();
+    _screenProjection.reset();
+}
+
+void IncrementalSelection::end()
+{
+    _active                 = false;
+    _numberOfPoints         = 0;
+    _numberOfSelectedPoints = 0;
+
+    _isSelected.clear();
+    _isSelected.shrink_to_fit();
+
+    _selectionMask.reset();
+    _screenProjection.reset();
+}
+
+bool IncrementalSelection::isActive() const
+{
+    return _active;
+}
+
+bool IncrementalSelection::update(const std::vector<mv::Vector2f>& positions, const SpatialIndex& spatialIndex, const SelectionMask& selectionMask, const ScreenProjection& screenProjection)
+{
+    if (!_active || positions.size() != _numberOfPoints)
+        begin(static_cast<std::uint32_t>(positions.size()));
+
+    std::uint32_t numberOfAddedPoints = 0, numberOfRemovedPoints = 0;
+
+    if (_screenProjection.has_value() && *_screenProjection == screenProjection) {
+
+        // Only the points under pixels which changed since the previous update can enter or leave the stroke area
+        const auto flippedPoints = SelectionKernel(positions, SelectionMask::getDifference(*_selectionMask, selectionMask), screenProjection).select(spatialIndex);
+
+        for (const auto localIndex : flippedPoints._localIndices) {
+            auto& word      = _isSelected[localIndex >> 6];
+            const auto bit  = std::uint64_t{ 1 } << (localIndex & 63);
+
+            if (word & bit)
+                numberOfRemovedPoints++;
+            else
+                numberOfAddedPoints++;
+
+            word ^= bit;
+        }
+    }
+    else {
+
+        // The mapping to screen space changed (or this is the first update), so test all points under the selection area
+        const auto selectedPoints = SelectionKernel(positions, selectionMask, screenProjection).select(spatialIndex);
+
+        std::vector<std::uint64_t> isSelected(_isSelected.size(), 0);
+
+        for (const auto localIndex : selectedPoints._localIndices)
+            isSelected[localIndex >> 6] |= std::uint64_t{ 1 } << (localIndex & 63);
+
+        for (std::size_t wordIndex = 0; wordIndex < isSelected.size(); wordIndex++) {
+            numberOfAddedPoints     += static_cast<std::uint32_t>(std::popcount(isSelected[wordIndex] & ~_isSelected[wordIndex]));
+            numberOfRemovedPoints   += static_cast<std::uint32_t>(std::popcount(_isSelected[wordIndex] & ~isSelected[wordIndex]));
+        }
+
+        _isSelected = std::move(isSelected);
+    }
+
+    _numberOfSelectedPoints += numberOfAddedPoints;
+    _numberOfSelectedPoints -= numberOfRemovedPoints;
+
+    _selectionMask      = selectionMask;
+    _screenProjection   = screenProjection;
+
+    return numberOfAddedPoints > 0 || numberOfRemovedPoints > 0;
+}
+
+std::vector<std::uint32_t> IncrementalSelection::getLocalIndices(const std::vector<mv::Vector2f>& positions, SpatialIndex::Rectangle& bounds) const
+{
+    std::vector<std::uint32_t> localIndices;
+
+    localIndices.reserve(_numberOfSelectedPoints);
+
+    bounds = {
+        std::numeric_limits<float>::max(),
+        std::numeric_limits<float>::lowest(),
+        std::numeric_limits<float>::max(),
+        std::numeric_limits<float>::lowest()
+    };
+
+    for (std::size_t wordIndex = 0; wordIndex < _isSelected.size(); wordIndex++) {
+        for (auto word = _isSelected[wordIndex]; word != 0; word &= word - 1) {
+            const auto localIndex   = static_cast<std::uint32_t>(wordIndex * 64 + static_cast<std::size_t>(std::countr_zero(word)));
+            const auto& position    = positions[localIndex];
+
+            localIndices.push_back(localIndex);
+
+            bounds._left    = std::min(bounds._left, position.x);
+            bounds._right   = std::max(bounds._right, position.x);
+            bounds._bottom  = std::min(bounds._bottom, position.y);
+            bounds._top     = std::max(bounds._top, position.y);
+        }
+    }
+
+    return localIndices;
+}
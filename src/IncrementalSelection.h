@@ -0,0 +1,63 @@
+#pragma once
+
+#include "SelectionKernel.h"
+#include "SpatialIndex.h"
+
+#include <graphics/Vector2f.h>
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+/**
+ * Incremental selection class
+ *
+ * State of a (brush or lasso) selection stroke in progress. Keeps a per-point bitset of the points
+ * which are inside the stroke area and the selection mask of the previous update, so that each
+ * update only has to test the points under the pixels which changed since the previous update.
+ *
+ * The core selection API only takes complete index lists, so the local indices of all points inside
+ * the stroke area are still collected (one pass over the bitset) whenever the stroke area changed.
+ */
+class IncrementalSelection
+{
+public:
+
+    /**
+     * Begin a stroke over \p numberOfPoints points
+     * @param numberOfPoints Number of points in the position dataset
+     */
+    void begin(std::uint32_t numberOfPoints);
+
+    /** End the stroke in progress and release its state */
+    void end();
+
+    /** Determines whether a stroke is in progress */
+    bool isActive() const;
+
+    /**
+     * Update the stroke with the current \p selectionMask
+     * @param positions Point positions in world space
+     * @param spatialIndex Spatial index over \p positions
+     * @param selectionMask Current selection mask of the stroke
+     * @param screenProjection Mapping from world space to screen space (the stroke restarts when it differs from the previous update)
+     * @return Whether any point entered or left the stroke area since the previous update
+     */
+    bool update(const std::vector<mv::Vector2f>& positions, const SpatialIndex& spatialIndex, const SelectionMask& selectionMask, const ScreenProjection& screenProjection);
+
+    /**
+     * Get the local indices of the points inside the stroke area
+     * @param positions Point positions in world space
+     * @param bounds World space bounds of the points inside the stroke area (inverted when empty)
+     * @return Sorted local indices
+     */
+    std::vector<std::uint32_t> getLocalIndices(const std::vector<mv::Vector2f>& positions, SpatialIndex::Rectangle& bounds) const;
+
+private:
+    bool                                _active = false;                /** Whether a stroke is in progress */
+    std::vector<std::uint64_t>          _isSelected;                    /** Per-point bitset of the points inside the stroke area */
+    std::uint32_t                       _numberOfPoints = 0;            /** Number of points the stroke covers */
+    std::uint32_t                       _numberOfSelectedPoints = 0;    /** Number of points inside the stroke area */
+    std::optional<SelectionMask>        _selectionMask;                 /** Selection mask of the previous update */
+    std::optional<ScreenProjection>     _screenProjection;              /** Screen projection of the previous update */
+};
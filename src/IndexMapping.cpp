@@ -0,0 +1,80 @@
+#include "IndexMapping.h"
+
+#include <algorithm>
+#include <utility>
+
+void IndexMapping::update(const mv::Dataset<Points>& points)
+{
+    invalidate();
+
+    if (!points.isValid())
+        return;
+
+    std::vector<std::uint32_t> globalIndices;
+
+    points->getGlobalIndices(globalIndices);
+
+    update(std::move(globalIndices));
+}
+
+void IndexMapping::update(std::vector<std::uint32_t> globalIndices)
+{
+    invalidate();
+
+    _globalIndices = std::move(globalIndices);
+
+    const auto numberOfPoints   = _globalIndices.size();
+    const auto globalRangeSize  = _globalIndices.empty() ? std::size_t{ 0 } : static_cast<std::size_t>(*std::max_element(_globalIndices.begin(), _globalIndices.end())) + 1;
+
+    if (globalRangeSize <= numberOfPoints * DENSE_RANGE_FACTOR) {
+        _localIndicesDense.assign(globalRangeSize, INVALID_INDEX);
+
+        for (std::uint32_t localIndex = 0; localIndex < numberOfPoints; localIndex++)
+            _localIndicesDense[_globalIndices[localIndex]] = localIndex;
+    }
+    else {
+        _localIndicesSparse.reserve(numberOfPoints);
+
+        for (std::uint32_t localIndex = 0; localIndex < numberOfPoints; localIndex++)
+            _localIndicesSparse.emplace(_globalIndices[localIndex], localIndex);
+    }
+
+    _valid = true;
+}
+
+void IndexMapping::invalidate()
+{
+    _valid = false;
+
+    _globalIndices.clear();
+    _localIndicesDense.clear();
+    _localIndicesSparse.clear();
+
+    _globalIndices.shrink_to_fit();
+    _localIndicesDense.shrink_to_fit();
+}
+
+bool IndexMapping::isValid() const
+{
+    return _valid;
+}
+
+std::uint32_t IndexMapping::getNumberOfPoints() const
+{
+    return static_cast<std::uint32_t>(_globalIndices.size());
+}
+
+const std::vector<std::uint32_t>& IndexMapping::getGlobalIndices() const
+{
+    return _globalIndices;
+}
+
+std::uint32_t IndexMapping::getLocalIndex(std::uint32_t globalIndex) const
+{
+    if (!_localIndicesDense.empty())
+        return globalIndex < _localIndicesDense.size() ? _localIndicesDense[globalIndex] : INVALID_INDEX;
+
+    const auto it = _localIndicesSparse.find(globalIndex);
+
+    return it != _localIndicesSparse.end() ? it->second : INVALID_INDEX;
+}
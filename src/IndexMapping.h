@@ -0,0 +1,75 @@
+#pragma once
+
+#include <Dataset.h>
+#include <PointData/PointData.h>
+
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Index mapping class
+ *
+ * Caches the mapping from local point indices of a points dataset to global indices (in its full
+ * source dataset) and the reverse lookup from global to local indices. The reverse lookup is a
+ * dense array when the dataset covers a considerable part of the global index range, and a hash
+ * map otherwise.
+ */
+class IndexMapping
+{
+public:
+
+    /** Returned for global indices which are not part of the dataset */
+    static constexpr std::uint32_t INVALID_INDEX = std::numeric_limits<std::uint32_t>::max();
+
+public:
+
+    /**
+     * Fill the mapping from \p points
+     * @param points Smart pointer to the points dataset
+     */
+    void update(const mv::Dataset<Points>& points);
+
+    /**
+     * Fill the mapping from the global index of each local index
+     * @param globalIndices Global index of each local index
+     */
+    void update(std::vector<std::uint32_t> globalIndices);
+
+    /** Release the mapping, it needs to be updated before use */
+    void invalidate();
+
+    /** Determines whether the mapping is filled */
+    bool isValid() const;
+
+    /** Get the number of points in the mapping */
+    std::uint32_t getNumberOfPoints() const;
+
+    /** Get the global index of each local index */
+    const std::vector<std::uint32_t>& getGlobalIndices() const;
+
+    /**
+     * Get the global index of \p localIndex
+     * @param localIndex Local point index
+     * @return Global point index
+     */
+    std::uint32_t getGlobalIndex(std::uint32_t localIndex) const {
+        return _globalIndices[localIndex];
+    }
+
+    /**
+     * Get the local index of \p globalIndex
+     * @param globalIndex Global point index
+     * @return Local point index, INVALID_INDEX when \p globalIndex is not part of the dataset
+     */
+    std::uint32_t getLocalIndex(std::uint32_t globalIndex) const;
+
+private:
+    bool                                                _valid = false;         /** Whether the mapping is filled */
+    std::vector<std::uint32_t>                          _globalIndices;         /** Global index of each local index */
+    std::vector<std::uint32_t>                          _localIndicesDense;     /** Local index of each global index (when dense) */
+    std::unordered_map<std::uint32_t, std::uint32_t>    _localIndicesSparse;    /** Local index of each global index (when sparse) */
+
+    static constexpr std::size_t DENSE_RANGE_FACTOR = 4;    /** The dense reverse lookup is used when the global index range is at most this many times the number of points */
+};
@@ -0,0 +1,150 @@
+#include "MappingCompatibilityCache.h"
+#include "MappingUtils.h"
+
+#include <QMetaObject>
+
+#include <utility>
+
+using namespace mv;
+
+MappingCompatibilityCache::MappingCompatibilityCache(QObject* parent) :
+    QObject(parent),
+    _entries(),
+    _droppedEntries()
+{
+}
+
+MappingCompatibilityCache::Compatibility MappingCompatibilityCache::getCompatibility(const Dataset<Points>& colors, const Dataset<Points>& positions)
+{
+    if (!colors.isValid() || !positions.isValid())
+        return {};
+
+    auto& entry = getEntry(colors, positions);
+
+    if (!entry._compatibility.has_value())
+        entry._compatibility = computeCompatibility(colors, positions);
+
+    return *entry._compatibility;
+}
+
+MappingCompatibilityCache::Strategy MappingCompatibilityCache::getStrategy(const Dataset<Points>& colors, const Dataset<Points>& positions)
+{
+    if (!colors.isValid() || !positions.isValid())
+        return Strategy::None;
+
+    auto& entry = getEntry(colors, positions);
+
+    if (!entry._strategy.has_value())
+        entry._strategy = computeStrategy(colors, positions);
+
+    return *entry._strategy;
+}
+
+void MappingCompatibilityCache::invalidate(const QString& datasetId)
+{
+    const auto numberOfDroppedEntries = _droppedEntries.size();
+
+    std::vector<std::pair<QString, QString>> droppedKeys;
+
+    for (auto it = _entries.begin(); it != _entries.end();) {
+        if (!it->second->_datasets.contains(datasetId)) {
+            ++it;
+            continue;
+        }
+
+        droppedKeys.push_back(it->first);
+
+        _droppedEntries.push_back(std::move(it->second));
+
+        it = _entries.erase(it);
+    }
+
+    if (numberOfDroppedEntries == 0 && !_droppedEntries.empty()) {
+        QMetaObject::invokeMethod(this, [this]() -> void {
+            _droppedEntries.clear();
+        }, Qt::QueuedConnection);
+    }
+
+    // Emitted once the entries are dropped, so that receivers which look up the pair again get a fresh entry
+    for (const auto& [colorsDatasetId, positionsDatasetId] : droppedKeys)
+        emit entryDropped(colorsDatasetId, positionsDatasetId);
+}
+
+MappingCompatibilityCache::Compatibility MappingCompatibilityCache::computeCompatibility(const Dataset<Points>& colors, const Dataset<Points>& positions)
+{
+    Compatibility compatibility;
+
+    compatibility._hasSameNumPoints         = colors->getNumPoints() == positions->getNumPoints();
+    compatibility._hasSameNumPointsAsFull   = fullSourceHasSameNumPoints(positions, colors);
+    compatibility._hasSelectionMapping      = checkSelectionMapping(colors, positions);
+
+    return compatibility;
+}
+
+MappingCompatibilityCache::Strategy MappingCompatibilityCache::computeStrategy(const Dataset<Points>& colors, const Dataset<Points>& positions)
+{
+    const auto numColorPoints       = colors->getNumPoints();
+    const auto numPositionPoints    = positions->getNumPoints();
+
+    if (numColorPoints == numPositionPoints)
+        return Strategy::SameNumberOfPoints;
+
+    if (fullSourceHasSameNumPoints(positions, colors))
+        return Strategy::GlobalIndices;
+
+    if (const auto [selectionMapping, numPointsTarget] = getSelectionMappingColorsToPositions(colors, positions);
+        selectionMapping != nullptr && numPointsTarget == numPositionPoints && checkSurjectiveMapping(*selectionMapping, numPointsTarget))
+        return Strategy::ColorsToPositions;
+
+    if (const auto [selectionMapping, numPointsTarget] = getSelectionMappingPositionsToColors(positions, colors);
+        selectionMapping != nullptr && numPointsTarget == numColorPoints && checkSurjectiveMapping(*selectionMapping, numPointsTarget))
+        return Strategy::PositionsToColors;
+
+    if (const auto [selectionMapping, numPointsTarget] = getSelectionMappingPositionSourceToColors(positions, colors);
+        selectionMapping != nullptr && numPointsTarget == numColorPoints && checkSurjectiveMapping(*selectionMapping, numPointsTarget))
+        return Strategy::PositionSourceToColors;
+
+    return Strategy::None;
+}
+
+MappingCompatibilityCache::Entry& MappingCompatibilityCache::getEntry(const Dataset<Points>& colors, const Dataset<Points>& positions)
+{
+    auto& entry = _entries[{ colors->getId(), positions->getId() }];
+
+    if (entry)
+        return *entry;
+
+    entry = std::make_unique<Entry>();
+
+    // The strategies also look at the parent and full source of derived positions
+    std::vector<Dataset<DatasetImpl>> datasets = { colors, positions };
+
+    if (positions->isDerivedData()) {
+        datasets.push_back(positions->getParent());
+        datasets.push_back(positions->getSourceDataset<Points>()->getFullDataset<Points>());
+    }
+
+    for (const auto& dataset : datasets) {
+        if (!dataset.isValid())
+            continue;
+
+        const auto datasetId = dataset->getId();
+
+        if (entry->_datasets.contains(datasetId))
+            continue;
+
+        auto& watchedDataset = entry->_datasets[datasetId];
+
+        watchedDataset = dataset;
+
+        connect(&watchedDataset, &Dataset<DatasetImpl>::dataChanged, this, [this, datasetId]() -> void {
+            invalidate(datasetId);
+        });
+
+        connect(&watchedDataset, &Dataset<DatasetImpl>::aboutToBeRemoved, this, [this, datasetId]() -> void {
+            invalidate(datasetId);
+        });
+    }
+
+    return *entry;
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <Dataset.h>
+#include <PointData/PointData.h>
+
+#include <QObject>
+#include <QString>
+
+#include <map>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+/**
+ * Mapping compatibility cache class
+ *
+ * Caches how a color points dataset maps onto a position points dataset, keyed by the identifiers
+ * of both datasets, so that drag hovers and re-coloring do not repeatedly scan linked data and
+ * check selection mappings for surjectivity. Entries are dropped when the data of any involved
+ * dataset (the colors, the positions and, for derived positions, their parent and full source)
+ * changes or it is about to be removed. Producers of points and selection mappings notify a data
+ * change once they are done, so lookups do not re-inspect the datasets.
+ */
+class MappingCompatibilityCache : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    /** Strategies to map color points onto position points, in order of preference (see MappingUtils.h) */
+    enum class Strategy {
+        SameNumberOfPoints,         /** Same number of points, no mapping needed */
+        GlobalIndices,              /** The full source of the positions has the same number of points as the colors */
+        ColorsToPositions,          /** Surjective selection mapping from the colors (or their parent) to the positions */
+        PositionsToColors,          /** Surjective selection mapping from the positions (or their parent) to the colors */
+        PositionSourceToColors,     /** Surjective selection mapping from the full source of the positions to the colors */
+        None                        /** The colors do not match the positions in a known way */
+    };
+
+    /** Cheap compatibility checks of a color dataset (which do not check selection mappings for surjectivity) */
+    struct Compatibility {
+        bool    _hasSameNumPoints       = false;    /** Whether both datasets have the same number of points */
+        bool    _hasSameNumPointsAsFull = false;    /** Whether the full source of the positions has the same number of points as the colors */
+        bool    _hasSelectionMapping    = false;    /** Whether there is a selection mapping between the datasets (or their parents/sources) */
+    };
+
+public:
+
+    /**
+     * Construct with \p parent object
+     * @param parent Pointer to parent object
+     */
+    MappingCompatibilityCache(QObject* parent = nullptr);
+
+    /**
+     * Get the compatibility of \p colors with \p positions (computed on first request)
+     * @param colors Smart pointer to the color points dataset
+     * @param positions Smart pointer to the position points dataset
+     * @return Compatibility (all false for invalid datasets)
+     */
+    Compatibility getCompatibility(const mv::Dataset<Points>& colors, const mv::Dataset<Points>& positions);
+
+    /**
+     * Get the strategy to map \p colors onto \p positions (computed on first request, including the surjectivity check)
+     * @param colors Smart pointer to the color points dataset
+     * @param positions Smart pointer to the position points dataset
+     * @return Mapping strategy (Strategy::None for invalid datasets)
+     */
+    Strategy getStrategy(const mv::Dataset<Points>& colors, const mv::Dataset<Points>& positions);
+
+    /**
+     * Drop the entries which involve the dataset with \p datasetId
+     * @param datasetId Globally unique identifier of the dataset
+     */
+    void invalidate(const QString& datasetId);
+
+    /**
+     * Compute the compatibility of \p colors with \p positions (without caching)
+     * @param colors Smart pointer to the color points dataset
+     * @param positions Smart pointer to the position points dataset
+     * @return Compatibility
+     */
+    static Compatibility computeCompatibility(const mv::Dataset<Points>& colors, const mv::Dataset<Points>& positions);
+
+    /**
+     * Compute the strategy to map \p colors onto \p positions (without caching)
+     * @param colors Smart pointer to the color points dataset
+     * @param positions Smart pointer to the position points dataset
+     * @return Mapping strategy
+     */
+    static Strategy computeStrategy(const mv::Dataset<Points>& colors, const mv::Dataset<Points>& positions);
+
+signals:
+
+    /**
+     * Signals that the entry of a pair of datasets was dropped, so that results derived from it are out of date
+     * @param colorsDatasetId Globally unique identifier of the color dataset
+     * @param positionsDatasetId Globally unique identifier of the position dataset
+     */
+    void entryDropped(const QString& colorsDatasetId, const QString& positionsDatasetId);
+
+private:
+
+    /** Cached compatibility of a pair of datasets */
+    struct Entry {
+        std::map<QString, mv::Dataset<mv::DatasetImpl>>     _datasets;          /** Involved datasets per identifier (watched for data changes and removal) */
+        std::optional<Compatibility>                        _compatibility;     /** Compatibility (once requested) */
+        std::optional<Strategy>                             _strategy;          /** Mapping strategy (once requested) */
+    };
+
+    /**
+     * Get the entry of \p colors and \p positions (created and watched on first request)
+     * @param colors Smart pointer to the color points dataset
+     * @param positions Smart pointer to the position points dataset
+     * @return Reference to the entry
+     */
+    Entry& getEntry(const mv::Dataset<Points>& colors, const mv::Dataset<Points>& positions);
+
+    std::map<std::pair<QString, QString>, std::unique_ptr<Entry>>   _entries;           /** Cached entries per color and position dataset identifier */
+    std::vector<std::unique_ptr<Entry>>                             _droppedEntries;    /** Dropped entries, released once control returns to the event loop (their datasets may be emitting) */
+};
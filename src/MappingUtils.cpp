@@ -1,4 +1,5 @@
 #include "MappingUtils.h"
+#include "ParallelUtils.h"
 
 #include <Dataset.h>
 #include <LinkedData.h>
@@ -6,9 +7,12 @@
 #include <Set.h>
 
 #include <algorithm>
+#include <atomic>
+#include <bit>
 #include <cstdint>
 #include <functional>
 #include <map>
+#include <numeric>
 #include <tuple>
 #include <ranges>
 #include <utility>
@@ -71,24 +75,93 @@ std::pair<const mv::LinkedData*, std::uint64_t> getSelectionMappingPositionSourc
 }
 
 bool checkSurjectiveMapping(const mv::LinkedData& linkedData, const std::uint32_t numPointsInTarget) {
-    const std::map<std::uint32_t, std::vector<std::uint32_t>>& linkedMap = linkedData.getMapping().getMap();
+    const auto& linkedMap = linkedData.getMapping().getMap();
 
-    std::vector<bool> found(numPointsInTarget, false);
-    std::uint32_t count = 0;
+    return checkSurjectiveMapping(linkedMap, numPointsInTarget, std::min<std::size_t>(getNumberOfChunks(linkedMap.size(), SURJECTIVITY_CHECK_MINIMUM_CHUNK_SIZE), std::max(1, QThread::idealThreadCount())));
+}
+
+bool checkSurjectiveMapping(const std::map<std::uint32_t, std::vector<std::uint32_t>>& linkedMap, const std::uint32_t numPointsInTarget, const std::size_t numberOfChunks) {
+    using LinkedMap = std::map<std::uint32_t, std::vector<std::uint32_t>>;
+
+    if (numPointsInTarget == 0 || linkedMap.empty())
+        return false;
+
+    const auto numberOfWords = (static_cast<std::size_t>(numPointsInTarget) + 63) / 64;
+
+    std::vector<std::uint64_t> found(numberOfWords, 0);
+
+    // Serially (also on a single core, where the early exit beats splitting), stop as soon as the entire target set is covered
+    if (numberOfChunks <= 1) {
+        std::uint32_t count = 0;
 
-    for (const auto& [key, vec] : linkedMap) {
-        for (const std::uint32_t val : vec) {
-            if (val >= numPointsInTarget) continue; // Skip values that are too large
+        for (const auto& [key, vec] : linkedMap) {
+            for (const std::uint32_t val : vec) {
+                if (val >= numPointsInTarget) continue; // Skip values that are too large
 
-            if (!found[val]) {
-                found[val] = true;
-                if (++count == numPointsInTarget)
-                    return true;
+                auto& word      = found[val / 64];
+                const auto bit  = std::uint64_t{ 1 } << (val % 64);
+
+                if ((word & bit) == 0) {
+                    word |= bit;
+
+                    if (++count == numPointsInTarget)
+                        return true;
+                }
             }
         }
+
+        return false; // The previous loop would have returned early if the entire taget set was covered
     }
 
-    return false; // The previous loop would have returned early if the entire taget set was covered
+    // Split the map into chunks of (roughly) equal key ranges, which can be walked concurrently
+    const std::uint64_t firstKey    = linkedMap.begin()->first;
+    const std::uint64_t keyRange    = static_cast<std::uint64_t>(linkedMap.rbegin()->first) - firstKey + 1;
+
+    std::vector<LinkedMap::const_iterator> chunkBegins(numberOfChunks + 1, linkedMap.end());
+
+    for (std::size_t chunkIndex = 0; chunkIndex < numberOfChunks; chunkIndex++)
+        chunkBegins[chunkIndex] = linkedMap.lower_bound(static_cast<std::uint32_t>(firstKey + keyRange * chunkIndex / numberOfChunks));
+
+    // Fewer mapped values than target points can never cover the target, no need to mark anything
+    std::vector<std::size_t> chunkNumberOfValues(numberOfChunks, 0);
+
+    forEachChunk(numberOfChunks, numberOfChunks, [&chunkBegins, &chunkNumberOfValues](std::size_t chunkIndex, std::size_t begin, std::size_t end) -> void {
+        for (auto it = chunkBegins[chunkIndex]; it != chunkBegins[chunkIndex + 1]; ++it)
+            chunkNumberOfValues[chunkIndex] += it->second.size();
+    });
+
+    if (std::accumulate(chunkNumberOfValues.begin(), chunkNumberOfValues.end(), std::size_t{ 0 }) < numPointsInTarget)
+        return false;
+
+    // All chunks mark the targets they hit in the shared bitset (words which already have the bit set are not written)
+    forEachChunk(numberOfChunks, numberOfChunks, [&chunkBegins, &found, numPointsInTarget](std::size_t chunkIndex, std::size_t begin, std::size_t end) -> void {
+        for (auto it = chunkBegins[chunkIndex]; it != chunkBegins[chunkIndex + 1]; ++it) {
+            for (const std::uint32_t val : it->second) {
+                if (val >= numPointsInTarget) continue; // Skip values that are too large
+
+                std::atomic_ref<std::uint64_t> word(found[val / 64]);
+
+                const auto bit = std::uint64_t{ 1 } << (val % 64);
+
+                if ((word.load(std::memory_order_relaxed) & bit) == 0)
+                    word.fetch_or(bit, std::memory_order_relaxed);
+            }
+        }
+    });
+
+    // Count the targets which are hit
+    std::vector<std::size_t> chunkCounts(numberOfChunks, 0);
+
+    forEachChunk(numberOfWords, numberOfChunks, [&found, &chunkCounts](std::size_t chunkIndex, std::size_t begin, std::size_t end) -> void {
+        std::size_t count = 0;
+
+        for (std::size_t wordIndex = begin; wordIndex < end; wordIndex++)
+            count += std::popcount(found[wordIndex]);
+
+        chunkCounts[chunkIndex] = count;
+    });
+
+    return std::accumulate(chunkCounts.begin(), chunkCounts.end(), std::size_t{ 0 }) == numPointsInTarget;
 }
 
 bool checkSelectionMapping(const mv::Dataset<Points>& colors, const mv::Dataset<Points>& positions) {
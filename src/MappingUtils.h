@@ -5,9 +5,12 @@
 #include <PointData/PointData.h>
 #include <Set.h>
 
+#include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <map>
 #include <utility>
+#include <vector>
 
 // This only checks the immedeate parent and is deliberately not recursive
 // We might consider the latter in the future, but might need to cover edge cases
@@ -51,9 +54,16 @@ std::pair<const mv::LinkedData*, std::uint64_t> getSelectionMappingPositionsToCo
 // Returns a mapping (linked data) from positions' source data whose target is colors 
 std::pair<const mv::LinkedData*, std::uint64_t> getSelectionMappingPositionSourceToColors(const mv::Dataset<Points>& positions, const mv::Dataset<Points>& colors);
 
+// Minimum number of mapping keys processed by a single thread in checkSurjectiveMapping
+constexpr std::size_t SURJECTIVITY_CHECK_MINIMUM_CHUNK_SIZE = 65536;
+
 // Check if the mapping is surjective, i.e. hits all elements in the target
+// Large mappings are split into key ranges, rejected up front when they have fewer values than the target has elements, and otherwise mark the hit elements in one shared bitset in parallel
 bool checkSurjectiveMapping(const mv::LinkedData& linkedData, const std::uint32_t numPointsInTarget);
 
+// Check if the selection map linkedMap (source index to target indices) hits all numPointsInTarget elements in the target, walking it in numberOfChunks key ranges (a single chunk walks it serially and exits early)
+bool checkSurjectiveMapping(const std::map<std::uint32_t, std::vector<std::uint32_t>>& linkedMap, const std::uint32_t numPointsInTarget, const std::size_t numberOfChunks);
+
 // returns whether there is a selection map from colors to positions or positions to colors (or respective parents)
 // checks whether the mapping covers all elements in the target
 bool checkSelectionMapping(const mv::Dataset<Points>& colors, const mv::Dataset<Points>& positions);
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <QThread>
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+// Helpers to split an index range [0, count) into contiguous chunks which are processed on the global thread pool
+
+// Returns the number of chunks a range of count elements is split into, such that each chunk holds at least minimumChunkSize elements
+inline std::size_t getNumberOfChunks(std::size_t count, std::size_t minimumChunkSize) {
+    if (count == 0)
+        return 0;
+
+    const auto maximumNumberOfChunks = static_cast<std::size_t>(std::max(1, QThread::idealThreadCount())) * 4;
+
+    return std::clamp<std::size_t>(count / std::max<std::size_t>(minimumChunkSize, 1), 1, maximumNumberOfChunks);
+}
+
+// Returns the [begin, end) range of chunk chunkIndex when count elements are split into numberOfChunks chunks
+inline std::pair<std::size_t, std::size_t> getChunkRange(std::size_t count, std::size_t numberOfChunks, std::size_t chunkIndex) {
+    return { count * chunkIndex / numberOfChunks, count * (chunkIndex + 1) / numberOfChunks };
+}
+
+/*  Invokes function(chunkIndex, begin, end) for each of the numberOfChunks chunks of [0, count), e.g.
+        const auto numberOfChunks = getNumberOfChunks(values.size(), 65536);
+        std::vector<float> chunkSums(numberOfChunks);
+        forEachChunk(values.size(), numberOfChunks, [&](std::size_t chunkIndex, std::size_t begin, std::size_t end) -> void {
+            chunkSums[chunkIndex] = std::accumulate(values.begin() + begin, values.begin() + end, 0.f);
+        });
+    Chunks are processed concurrently (blocking until all are done), a single chunk is processed on the calling thread.
+    Chunk indices follow the element order, so per-chunk results concatenated by chunk index preserve the element order.
+*/
+template<typename Function>
+void forEachChunk(std::size_t count, std::size_t numberOfChunks, Function function) {
+    if (count == 0 || numberOfChunks == 0)
+        return;
+
+    if (numberOfChunks == 1) {
+        function(std::size_t{ 0 }, std::size_t{ 0 }, count);
+        return;
+    }
+
+    std::vector<std::size_t> chunkIndices(numberOfChunks);
+
+    std::iota(chunkIndices.begin(), chunkIndices.end(), 0);
+
+    QtConcurrent::blockingMap(chunkIndices, [count, numberOfChunks, &function](const std::size_t& chunkIndex) -> void {
+        const auto [begin, end] = getChunkRange(count, numberOfChunks, chunkIndex);
+
+        function(chunkIndex, begin, end);
+    });
+}
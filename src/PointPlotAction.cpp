@@ -1,4 +1,6 @@
 #include "PointPlotAction.h"
+#include "ColumnView.h"
+#include "ScalarKernels.h"
 #include "ScalarSourceAction.h"
 #include "ScatterplotPlugin.h"
 #include "ScatterplotWidget.h"
@@ -14,6 +16,8 @@ PointPlotAction::PointPlotAction(QObject* parent, const QString& title) :
     _opacityAction(this, "Point opacity", 0.0, 100.0, DEFAULT_POINT_OPACITY),
     _pointSizeScalars(),
     _pointOpacityScalars(),
+    _pointSizeSelectionScalars(),
+    _pointOpacitySelectionScalars(),
     _focusSelection(this, "Focus selection"),
     _lastOpacitySourceIndex(-1)
 {
@@ -150,8 +154,14 @@ void PointPlotAction::initialize(ScatterplotPlugin* scatterplotPlugin)
 
     connect(&_scatterplotPlugin->getPositionDataset(), &Dataset<Points>::childAdded, this, &PointPlotAction::updateDefaultDatasets);
     connect(&_scatterplotPlugin->getPositionDataset(), &Dataset<Points>::childRemoved, this, &PointPlotAction::updateDefaultDatasets);
-    connect(&_scatterplotPlugin->getPositionDataset(), &Dataset<Points>::dataSelectionChanged, this, &PointPlotAction::updateScatterPlotWidgetPointSizeScalars);
-    connect(&_scatterplotPlugin->getPositionDataset(), &Dataset<Points>::dataSelectionChanged, this, &PointPlotAction::updateScatterPlotWidgetPointOpacityScalars);
+    connect(_scatterplotPlugin, &ScatterplotPlugin::selectionStateChanged, this, [this]() -> void {
+        // Only selection-driven scalars depend on the selection
+        if (_sizeAction.isSourceSelection())
+            updateScatterPlotWidgetPointSizeScalars();
+
+        if (_opacityAction.isSourceSelection())
+            updateScatterPlotWidgetPointOpacityScalars();
+    });
 
     connect(&_sizeAction, &ScalarAction::magnitudeChanged, this, &PointPlotAction::updateScatterPlotWidgetPointSizeScalars);
     connect(&_sizeAction, &ScalarAction::offsetChanged, this, &PointPlotAction::updateScatterPlotWidgetPointSizeScalars);
@@ -268,28 +278,23 @@ void PointPlotAction::updateScatterPlotWidgetPointSizeScalars()
 
     const auto numberOfPoints = _scatterplotPlugin->getPositionDataset()->getNumPoints();
 
-    if (numberOfPoints != _pointSizeScalars.size())
+    if (numberOfPoints != _pointSizeScalars.size()) {
         _pointSizeScalars.resize(numberOfPoints);
+        _pointSizeSelectionScalars = {};
+    }
 
-    std::fill(_pointSizeScalars.begin(), _pointSizeScalars.end(), _sizeAction.getMagnitudeAction().getValue());
+    // Maximum of the point size scalars, tracked along so that the widget does not need to scan them
+    auto maximumPointSize = _sizeAction.getMagnitudeAction().getValue();
 
     if (_sizeAction.isSourceSelection()) {
-        auto positionDataset = _scatterplotPlugin->getPositionDataset();
-
-        std::fill(_pointSizeScalars.begin(), _pointSizeScalars.end(), _sizeAction.getMagnitudeAction().getValue());
-
         const auto pointSizeSelectedPoints = _sizeAction.getMagnitudeAction().getValue() + _sizeAction.getSourceAction().getOffsetAction().getValue();
 
-        std::vector<bool> selected;
-
-        positionDataset->selectedLocalIndices(positionDataset->getSelection<Points>()->indices, selected);
-
-        for (size_t i = 0; i < selected.size(); i++) {
-            if (!selected[i])
-                continue;
+        maximumPointSize = updateSelectionScalars(_pointSizeScalars, _pointSizeSelectionScalars, _sizeAction.getMagnitudeAction().getValue(), pointSizeSelectedPoints);
+    }
+    else {
+        _pointSizeSelectionScalars = {};
 
-            _pointSizeScalars[i] = pointSizeSelectedPoints;
-        }
+        std::fill(_pointSizeScalars.begin(), _pointSizeScalars.end(), _sizeAction.getMagnitudeAction().getValue());
     }
 
     if (_sizeAction.isSourceDataset()) {
@@ -298,30 +303,40 @@ void PointPlotAction::updateScatterPlotWidgetPointSizeScalars()
 
         if (pointSizeSourceDataset.isValid() && pointSizeSourceDataset->getNumPoints() == _scatterplotPlugin->getPositionDataset()->getNumPoints())
         {
-            pointSizeSourceDataset->visitData([this, pointSizeSourceDataset, numberOfPoints](auto pointData) {
-                const auto currentDimensionIndex    = _sizeAction.getSourceAction().getDimensionPickerAction().getCurrentDimensionIndex();
-                const auto rangeMin                 = _sizeAction.getSourceAction().getRangeAction().getMinimum();
-                const auto rangeMax                 = _sizeAction.getSourceAction().getRangeAction().getMaximum();
-                const auto rangeLength              = rangeMax - rangeMin;
+            const auto currentDimensionIndex    = _sizeAction.getSourceAction().getDimensionPickerAction().getCurrentDimensionIndex();
+            const auto pointSizeOffset          = _sizeAction.getSourceAction().getOffsetAction().getValue();
+            const auto pointSizeMagnitude       = _sizeAction.getMagnitudeAction().getValue();
+            const auto rangeMin                 = _sizeAction.getSourceAction().getRangeAction().getMinimum();
+            const auto rangeMax                 = _sizeAction.getSourceAction().getRangeAction().getMaximum();
+            const auto rangeLength              = rangeMax - rangeMin;
 
-                if (rangeLength > 0) {
-                    for (std::uint32_t pointIndex = 0; pointIndex < numberOfPoints; pointIndex++) {
-                        auto pointValue = static_cast<float>(pointData[pointIndex][currentDimensionIndex]);
+            if (rangeLength > 0) {
+                auto isComputed = false;
 
-                        const auto pointValueClamped    = std::max(rangeMin, std::min(rangeMax, pointValue));
-                        const auto pointValueNormalized = (pointValueClamped - rangeMin) / rangeLength;
+                visitColumn(*pointSizeSourceDataset, currentDimensionIndex, [this, &isComputed, numberOfPoints, pointSizeOffset, pointSizeMagnitude, rangeMin, rangeMax](const auto& column) -> void {
+                    if (column.size() != numberOfPoints)
+                        return;
 
-                        _pointSizeScalars[pointIndex] = _sizeAction.getSourceAction().getOffsetAction().getValue() + (pointValueNormalized * _sizeAction.getMagnitudeAction().getValue());
-                    }
-                }
-                else {
-                    std::fill(_pointSizeScalars.begin(), _pointSizeScalars.end(), _sizeAction.getSourceAction().getOffsetAction().getValue() + (rangeMin * _sizeAction.getMagnitudeAction().getValue()));
+                    computeNormalizedScalars(column, _pointSizeScalars, rangeMin, rangeMax, pointSizeOffset, pointSizeMagnitude);
+
+                    isComputed = true;
+                });
+
+                if (isComputed) {
+                    const auto statistics = _scatterplotPlugin->getColumnStatisticsCache().getStatistics(pointSizeSourceDataset, currentDimensionIndex);
+
+                    maximumPointSize = getMaximumNormalizedScalar(statistics, rangeMin, rangeMax, pointSizeOffset, pointSizeMagnitude);
                 }
-            });
+            }
+            else {
+                maximumPointSize = pointSizeOffset + (rangeMin * pointSizeMagnitude);
+
+                std::fill(_pointSizeScalars.begin(), _pointSizeScalars.end(), maximumPointSize);
+            }
         }
     }
 
-    _scatterplotPlugin->getScatterplotWidget().setPointSizeScalars(_pointSizeScalars);
+    _scatterplotPlugin->getScatterplotWidget().setPointSizeScalars(_pointSizeScalars, maximumPointSize);
 }
 
 void PointPlotAction::updateScatterPlotWidgetPointOpacityScalars()
@@ -334,67 +349,84 @@ void PointPlotAction::updateScatterPlotWidgetPointOpacityScalars()
 
     const auto numberOfPoints = _scatterplotPlugin->getPositionDataset()->getNumPoints();
 
-    if (numberOfPoints != _pointOpacityScalars.size())
+    if (numberOfPoints != _pointOpacityScalars.size()) {
         _pointOpacityScalars.resize(numberOfPoints);
+        _pointOpacitySelectionScalars = {};
+    }
 
     const auto opacityMagnitude = 0.01f * _opacityAction.getMagnitudeAction().getValue();
 
-    std::fill(_pointOpacityScalars.begin(), _pointOpacityScalars.end(), opacityMagnitude);
-
     if (_opacityAction.isSourceSelection()) {
-        auto positionDataset    = _scatterplotPlugin->getPositionDataset();
-        auto selectionSet       = positionDataset->getSelection<Points>();
-
-        std::fill(_pointOpacityScalars.begin(), _pointOpacityScalars.end(), 0.01f * _opacityAction.getMagnitudeAction().getValue());
-
         const auto opacityOffset                = 0.01f * _opacityAction.getSourceAction().getOffsetAction().getValue();
         const auto pointOpacitySelectedPoints   = std::min(1.0f, opacityMagnitude + opacityOffset);
 
-        std::vector<uint32_t> localSelectionIndices;
-        positionDataset->getLocalSelectionIndices(localSelectionIndices);
+        updateSelectionScalars(_pointOpacityScalars, _pointOpacitySelectionScalars, opacityMagnitude, pointOpacitySelectedPoints);
+    }
+    else {
+        _pointOpacitySelectionScalars = {};
 
-        for (const auto& selectionIndex : localSelectionIndices)
-            _pointOpacityScalars[selectionIndex] = pointOpacitySelectedPoints;
+        std::fill(_pointOpacityScalars.begin(), _pointOpacityScalars.end(), opacityMagnitude);
     }
 
     if (_opacityAction.isSourceDataset()) {
         auto pointOpacitySourceDataset = Dataset<Points>(_opacityAction.getCurrentDataset());
 
         if (pointOpacitySourceDataset.isValid() && pointOpacitySourceDataset->getNumPoints() == _scatterplotPlugin->getPositionDataset()->getNumPoints()) {
-            pointOpacitySourceDataset->visitData([this, pointOpacitySourceDataset, numberOfPoints, opacityMagnitude](auto pointData) {
-                const auto currentDimensionIndex    = _opacityAction.getSourceAction().getDimensionPickerAction().getCurrentDimensionIndex();
-                const auto opacityOffset            = 0.01f * _opacityAction.getSourceAction().getOffsetAction().getValue();
-                const auto rangeMin                 = _opacityAction.getSourceAction().getRangeAction().getMinimum();
-                const auto rangeMax                 = _opacityAction.getSourceAction().getRangeAction().getMaximum();
-                const auto rangeLength              = rangeMax - rangeMin;
-
-                if (rangeLength > 0) {
-                    for (std::uint32_t pointIndex = 0; pointIndex < numberOfPoints; pointIndex++) {
-                        auto pointValue                 = static_cast<float>(pointData[pointIndex][currentDimensionIndex]);
-                        const auto pointValueClamped    = std::max(rangeMin, std::min(rangeMax, pointValue));
-                        const auto pointValueNormalized = (pointValueClamped - rangeMin) / rangeLength;
-
-                        if (opacityOffset == 1.0f)
-                            _pointOpacityScalars[pointIndex] = 1.0f;
-                        else
-                            _pointOpacityScalars[pointIndex] = opacityMagnitude * (opacityOffset + (pointValueNormalized / (1.0f - opacityOffset)));
-                    }
-                }
-                else {
-                    auto& rangeAction = _opacityAction.getSourceAction().getRangeAction();
+            const auto currentDimensionIndex    = _opacityAction.getSourceAction().getDimensionPickerAction().getCurrentDimensionIndex();
+            const auto opacityOffset            = 0.01f * _opacityAction.getSourceAction().getOffsetAction().getValue();
+            const auto rangeMin                 = _opacityAction.getSourceAction().getRangeAction().getMinimum();
+            const auto rangeMax                 = _opacityAction.getSourceAction().getRangeAction().getMaximum();
+            const auto rangeLength              = rangeMax - rangeMin;
+
+            if (rangeLength > 0) {
+                visitColumn(*pointOpacitySourceDataset, currentDimensionIndex, [this, numberOfPoints, opacityMagnitude, opacityOffset, rangeMin, rangeMax](const auto& column) -> void {
+                    if (column.size() == numberOfPoints)
+                        computeOpacityScalars(column, _pointOpacityScalars, rangeMin, rangeMax, opacityMagnitude, opacityOffset);
+                });
+            }
+            else {
+                auto& rangeAction = _opacityAction.getSourceAction().getRangeAction();
 
-                    if (rangeAction.getRangeMinAction().getValue() == rangeAction.getRangeMaxAction().getValue())
-                        std::fill(_pointOpacityScalars.begin(), _pointOpacityScalars.end(), 0.0f);
-                    else
-                        std::fill(_pointOpacityScalars.begin(), _pointOpacityScalars.end(), 1.0f);
-                }
-            });
+                if (rangeAction.getRangeMinAction().getValue() == rangeAction.getRangeMaxAction().getValue())
+                    std::fill(_pointOpacityScalars.begin(), _pointOpacityScalars.end(), 0.0f);
+                else
+                    std::fill(_pointOpacityScalars.begin(), _pointOpacityScalars.end(), 1.0f);
+            }
         }
     }
 
     _scatterplotPlugin->getScatterplotWidget().setPointOpacityScalars(_pointOpacityScalars);
 }
 
+float PointPlotAction::updateSelectionScalars(std::vector<float>& scalars, SelectionScalars& selectionScalars, float unselectedValue, float selectedValue) const
+{
+    const auto& selectionState = _scatterplotPlugin->getSelectionState();
+
+    // Only the points of the previously applied selection need to be reset when the scalar values did not change
+    if (selectionScalars._isValid && selectionScalars._unselectedValue == unselectedValue && selectionScalars._selectedValue == selectedValue) {
+        for (const auto& localIndex : selectionScalars._localIndices)
+            scalars[localIndex] = unselectedValue;
+    }
+    else {
+        std::fill(scalars.begin(), scalars.end(), unselectedValue);
+    }
+
+    // The selection state lags behind when the position data just changed, it is updated (and signalled) once the plugin has loaded the new data
+    if (selectionState.getNumberOfPoints() == scalars.size())
+        selectionScalars._localIndices.assign(selectionState.getLocalIndices().begin(), selectionState.getLocalIndices().end());
+    else
+        selectionScalars._localIndices.clear();
+
+    for (const auto& localIndex : selectionScalars._localIndices)
+        scalars[localIndex] = selectedValue;
+
+    selectionScalars._isValid           = true;
+    selectionScalars._unselectedValue   = unselectedValue;
+    selectionScalars._selectedValue     = selectedValue;
+
+    return selectionScalars._localIndices.empty() ? unselectedValue : std::max(unselectedValue, selectedValue);
+}
+
 void PointPlotAction::connectToPublicAction(WidgetAction* publicAction, bool recursive)
 {
     auto publicPointPlotAction = dynamic_cast<PointPlotAction*>(publicAction);
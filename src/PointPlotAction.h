@@ -4,6 +4,11 @@
 
 #include "ScalarAction.h"
 
+#include <QString>
+
+#include <cstdint>
+#include <vector>
+
 class ScatterplotPlugin;
 
 using namespace mv::gui;
@@ -81,6 +86,24 @@ protected:
     /** Update the scatter plot widget point opacity scalars */
     void updateScatterPlotWidgetPointOpacityScalars();
 
+    /** Selection-driven scalars in a scalars buffer, kept so that selection changes only patch the points which changed selection */
+    struct SelectionScalars {
+        bool                        _isValid = false;           /** Whether the scalars buffer holds the selection-driven scalars described below */
+        float                       _unselectedValue = 0.0f;    /** Scalar of unselected points */
+        float                       _selectedValue = 0.0f;      /** Scalar of selected points */
+        std::vector<std::uint32_t>  _localIndices;              /** Local indices of the points which have the selected scalar */
+    };
+
+    /**
+     * Set \p scalars to \p selectedValue for selected points and \p unselectedValue otherwise (only patching the points which changed selection when \p selectionScalars is valid for the same values)
+     * @param scalars Scalars buffer with one scalar per point
+     * @param selectionScalars Selection-driven scalars currently in \p scalars (updated)
+     * @param unselectedValue Scalar of unselected points
+     * @param selectedValue Scalar of selected points
+     * @return Maximum of \p scalars
+     */
+    float updateSelectionScalars(std::vector<float>& scalars, SelectionScalars& selectionScalars, float unselectedValue, float selectedValue) const;
+
 protected: // Linking
 
     /**
@@ -117,13 +140,15 @@ public: // Action getters
     ToggleAction& getFocusSelection() { return _focusSelection; }
 
 private:
-    ScatterplotPlugin*      _scatterplotPlugin;         /** Pointer to scatterplot plugin */
-    ScalarAction            _sizeAction;                /** Point size action */
-    ScalarAction            _opacityAction;             /** Point opacity action */
-    std::vector<float>      _pointSizeScalars;          /** Cached point size scalars */
-    std::vector<float>      _pointOpacityScalars;       /** Cached point opacity scalars */
-    ToggleAction            _focusSelection;            /** Focus selection action */
-    std::int32_t            _lastOpacitySourceIndex;    /** Last opacity source index that was selected */
+    ScatterplotPlugin*      _scatterplotPlugin;               /** Pointer to scatterplot plugin */
+    ScalarAction            _sizeAction;                      /** Point size action */
+    ScalarAction            _opacityAction;                   /** Point opacity action */
+    std::vector<float>      _pointSizeScalars;                /** Cached point size scalars */
+    std::vector<float>      _pointOpacityScalars;             /** Cached point opacity scalars */
+    SelectionScalars        _pointSizeSelectionScalars;       /** Selection-driven point size scalars */
+    SelectionScalars        _pointOpacitySelectionScalars;    /** Selection-driven point opacity scalars */
+    ToggleAction            _focusSelection;                  /** Focus selection action */
+    std::int32_t            _lastOpacitySourceIndex;          /** Last opacity source index that was selected */
 
     static constexpr double DEFAULT_POINT_SIZE      = 10.0;     /** Default point size */
     static constexpr double DEFAULT_POINT_OPACITY   = 50.0;     /** Default point opacity */
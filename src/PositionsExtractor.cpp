@@ -0,0 +1,153 @@
+#include "PositionsExtractor.h"
+#include "ColumnView.h"
+
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <utility>
+
+using namespace mv;
+
+PositionsExtractor::PositionsExtractor(QObject* parent) :
+    QObject(parent),
+    _points(),
+    _futureWatcher(),
+    _pendingRequest(),
+    _generation(0),
+    _runningGeneration(0),
+    _isInterrupted(false),
+    _result()
+{
+    connect(&_futureWatcher, &QFutureWatcher<std::optional<Result>>::finished, this, &PositionsExtractor::extractionFinished);
+
+    // The thread pool reads the dataset, so it has to let go before the data changes further or the dataset is removed
+    connect(&_points, &Dataset<Points>::dataChanged, this, &PositionsExtractor::interrupt);
+    connect(&_points, &Dataset<Points>::aboutToBeRemoved, this, &PositionsExtractor::interrupt);
+}
+
+PositionsExtractor::~PositionsExtractor()
+{
+    interrupt();
+}
+
+PositionsExtractor::Result PositionsExtractor::extract(const Points& points, std::int32_t dimensionX, std::int32_t dimensionY)
+{
+    Result result;
+
+    points.extractDataForDimensions(result._positions, dimensionX, dimensionY);
+
+    result._spatialIndex.build(result._positions);
+
+    return result;
+}
+
+void PositionsExtractor::start(const Dataset<Points>& points, std::int32_t dimensionX, std::int32_t dimensionY)
+{
+    // Only the dataset of the running extraction is watched, so it has to finish before another dataset is watched
+    if (points != _points)
+        interrupt();
+
+    _points = points;
+
+    _generation++;
+
+    _pendingRequest = Request{ dimensionX, dimensionY, _generation };
+
+    // A running extraction is not interrupted by a new request, the pending request starts once it finishes
+    if (!_futureWatcher.isRunning())
+        startPendingRequest();
+}
+
+void PositionsExtractor::cancel()
+{
+    _generation++;
+
+    _pendingRequest.reset();
+}
+
+PositionsExtractor::Result PositionsExtractor::takeResult()
+{
+    return std::exchange(_result, {});
+}
+
+void PositionsExtractor::startPendingRequest()
+{
+    const auto request = *_pendingRequest;
+
+    _pendingRequest.reset();
+
+    if (!_points.isValid())
+        return;
+
+    _runningGeneration  = request._generation;
+    _isInterrupted      = false;
+
+    _futureWatcher.setFuture(QtConcurrent::run([this](const Points* points, std::int32_t dimensionX, std::int32_t dimensionY) -> std::optional<Result> {
+        Result result;
+
+        if (!extractPositions(*points, dimensionX, dimensionY, result._positions, _isInterrupted))
+            return std::nullopt;
+
+        result._spatialIndex.build(result._positions);
+
+        return result;
+    }, _points.get(), request._dimensionX, request._dimensionY));
+}
+
+void PositionsExtractor::extractionFinished()
+{
+    // The result is stale when a newer request is pending
+    if (_pendingRequest.has_value()) {
+        startPendingRequest();
+        return;
+    }
+
+    if (_runningGeneration != _generation)
+        return;
+
+    auto result = _futureWatcher.future().takeResult();
+
+    if (!result.has_value())
+        return;
+
+    _result = std::move(*result);
+
+    emit finished();
+}
+
+void PositionsExtractor::interrupt()
+{
+    if (!_futureWatcher.isRunning())
+        return;
+
+    _isInterrupted = true;
+
+    _futureWatcher.waitForFinished();
+}
+
+bool PositionsExtractor::extractPositions(const Points& points, std::int32_t dimensionX, std::int32_t dimensionY, std::vector<mv::Vector2f>& positions, const std::atomic<bool>& isInterrupted)
+{
+    auto isComplete = false;
+
+    visitColumns(points, { dimensionX, dimensionY }, [&positions, &isInterrupted, &isComplete](const auto& columns) -> void {
+        const auto& columnX = columns[0];
+        const auto& columnY = columns[1];
+        const auto  count   = columnX.size();
+
+        positions.resize(count);
+
+        for (std::size_t begin = 0; begin < count; begin += COLUMN_EXTRACTION_MINIMUM_CHUNK_SIZE) {
+            if (isInterrupted)
+                return;
+
+            const auto end = std::min(begin + COLUMN_EXTRACTION_MINIMUM_CHUNK_SIZE, count);
+
+            for (std::size_t pointIndex = begin; pointIndex < end; pointIndex++)
+                positions[pointIndex] = mv::Vector2f(static_cast<float>(columnX[pointIndex]), static_cast<float>(columnY[pointIndex]));
+        }
+
+        isComplete = true;
+    });
+
+    return isComplete;
+}
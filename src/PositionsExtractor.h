@@ -0,0 +1,120 @@
+#pragma once
+
+#include "SpatialIndex.h"
+
+#include <Dataset.h>
+#include <PointData/PointData.h>
+
+#include <graphics/Vector2f.h>
+
+#include <QFutureWatcher>
+#include <QObject>
+
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+/**
+ * Positions extractor class
+ *
+ * Extracts the two-dimensional point positions from a points dataset and indexes them, either
+ * synchronously or on the global thread pool. The thread pool copies the positions in chunks, and
+ * stops at the next chunk (after which the extractor waits for it) when the data of the dataset
+ * changes or the dataset is about to be removed. Asynchronous requests supersede each other: while
+ * an extraction is running only the most recent request is kept, and results of superseded,
+ * interrupted or cancelled requests are discarded.
+ */
+class PositionsExtractor : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    /** Extracted positions */
+    struct Result {
+        std::vector<mv::Vector2f>   _positions;         /** Point positions in world space */
+        SpatialIndex                _spatialIndex;      /** Uniform grid over the point positions */
+    };
+
+public:
+
+    /**
+     * Construct with \p parent object
+     * @param parent Pointer to parent object
+     */
+    PositionsExtractor(QObject* parent = nullptr);
+
+    /** Waits for a running extraction to finish */
+    ~PositionsExtractor() override;
+
+    /**
+     * Extract dimensions \p dimensionX and \p dimensionY from \p points (on the calling thread)
+     * @param points Points dataset
+     * @param dimensionX Index of the x-dimension
+     * @param dimensionY Index of the y-dimension
+     * @return Extracted positions
+     */
+    static Result extract(const Points& points, std::int32_t dimensionX, std::int32_t dimensionY);
+
+    /**
+     * Extract dimensions \p dimensionX and \p dimensionY from \p points and index them on the thread pool, supersedes previous requests
+     * @param points Smart pointer to the points dataset
+     * @param dimensionX Index of the x-dimension
+     * @param dimensionY Index of the y-dimension
+     */
+    void start(const mv::Dataset<Points>& points, std::int32_t dimensionX, std::int32_t dimensionY);
+
+    /** Discard the results of all requests so far */
+    void cancel();
+
+    /**
+     * Take the result of the most recent request (valid after the finished signal)
+     * @return Extracted positions
+     */
+    Result takeResult();
+
+signals:
+
+    /** Signals that the most recent request finished and its result can be taken */
+    void finished();
+
+private:
+
+    /** Start the extraction of the pending request */
+    void startPendingRequest();
+
+    /** Invoked when an extraction finished */
+    void extractionFinished();
+
+    /** Stop the running extraction at its next chunk and wait for it, the dataset is about to change or be removed */
+    void interrupt();
+
+    /**
+     * Copy dimensions \p dimensionX and \p dimensionY from \p points into \p positions chunk by chunk
+     * @param points Points dataset
+     * @param dimensionX Index of the x-dimension
+     * @param dimensionY Index of the y-dimension
+     * @param positions Extracted positions (resized to the number of points)
+     * @param isInterrupted Checked before each chunk, the copy stops when it is set
+     * @return Whether all positions were copied
+     */
+    static bool extractPositions(const Points& points, std::int32_t dimensionX, std::int32_t dimensionY, std::vector<mv::Vector2f>& positions, const std::atomic<bool>& isInterrupted);
+
+private:
+
+    /** Extraction request */
+    struct Request {
+        std::int32_t                _dimensionX;        /** Index of the x-dimension */
+        std::int32_t                _dimensionY;        /** Index of the y-dimension */
+        std::uint64_t               _generation;        /** Generation of the request */
+    };
+
+    mv::Dataset<Points>                         _points;                /** Smart pointer to the points dataset of the most recent request (watched for data changes and removal) */
+    QFutureWatcher<std::optional<Result>>       _futureWatcher;         /** Watches the running extraction (no result when it was interrupted) */
+    std::optional<Request>                      _pendingRequest;        /** Most recent request which waits for the running extraction */
+    std::uint64_t                               _generation;            /** Generation of the most recent request (incremented for each request and on cancel) */
+    std::uint64_t                               _runningGeneration;     /** Generation of the running extraction */
+    std::atomic<bool>                           _isInterrupted;         /** Whether the running extraction should stop at its next chunk */
+    Result                                      _result;                /** Result of the most recent request */
+};
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "ColumnStatistics.h"
+#include "ParallelUtils.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+// Kernels which map a column of point values to per-point render scalars (point size and opacity), processed in parallel chunks
+
+// Minimum number of points processed by a single thread in the scalar kernels
+constexpr std::size_t SCALAR_KERNELS_MINIMUM_CHUNK_SIZE = 262144;
+
+/*  Sets scalars[i] = offset + scale * normalized(column[i]) for the first scalars.size() points, where the value is clamped to
+    [rangeMin, rangeMax] and normalized to [0, 1]. Column is anything indexable with operator[] (e.g. a ColumnView or a vector).
+    Requires rangeMax > rangeMin.
+*/
+template<typename Column>
+void computeNormalizedScalars(const Column& column, std::vector<float>& scalars, float rangeMin, float rangeMax, float offset, float scale) {
+    const auto count                = scalars.size();
+    const auto normalizationScale   = scale / (rangeMax - rangeMin);
+
+    forEachChunk(count, getNumberOfChunks(count, SCALAR_KERNELS_MINIMUM_CHUNK_SIZE), [&column, &scalars, rangeMin, rangeMax, offset, normalizationScale](std::size_t chunkIndex, std::size_t begin, std::size_t end) -> void {
+        auto output = scalars.data();
+
+        for (std::size_t pointIndex = begin; pointIndex < end; pointIndex++) {
+            const auto pointValueClamped = std::max(rangeMin, std::min(rangeMax, static_cast<float>(column[pointIndex])));
+
+            output[pointIndex] = offset + (pointValueClamped - rangeMin) * normalizationScale;
+        }
+    });
+}
+
+/*  Sets the point opacity scalars from column, given the opacity magnitude and offset (both in [0, 1]):
+        scalars[i] = magnitude * (offset + normalized(column[i]) / (1 - offset))
+    A full offset makes all points opaque. Requires rangeMax > rangeMin.
+*/
+template<typename Column>
+void computeOpacityScalars(const Column& column, std::vector<float>& scalars, float rangeMin, float rangeMax, float magnitude, float offset) {
+    if (offset == 1.0f) {
+        std::fill(scalars.begin(), scalars.end(), 1.0f);
+        return;
+    }
+
+    computeNormalizedScalars(column, scalars, rangeMin, rangeMax, magnitude * offset, magnitude / (1.0f - offset));
+}
+
+/*  Returns the maximum of the scalars computed by computeNormalizedScalars from a column with the given statistics, without scanning
+    the scalars (the mapping is monotonic). Non-finite values are assumed to map to the top of the range, which makes the result an
+    upper bound for columns which contain negative infinities only.
+*/
+inline float getMaximumNormalizedScalar(const ColumnStatistics& statistics, float rangeMin, float rangeMax, float offset, float scale) {
+    const auto columnMaximum        = statistics.getNumberOfNonFiniteValues() > 0 || !statistics.hasFiniteValues() ? rangeMax : statistics._maximum;
+    const auto columnMinimum        = statistics.hasFiniteValues() ? statistics._minimum : rangeMax;
+    const auto normalizationScale   = scale / (rangeMax - rangeMin);
+
+    const auto getScalar = [rangeMin, rangeMax, offset, normalizationScale](float value) -> float {
+        return offset + (std::max(rangeMin, std::min(rangeMax, value)) - rangeMin) * normalizationScale;
+    };
+
+    return std::max(getScalar(columnMinimum), getScalar(columnMaximum));
+}
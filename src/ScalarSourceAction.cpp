@@ -3,6 +3,7 @@
 
 #include <PointData/PointData.h>
 
+#include <QDebug>
 #include <QGridLayout>
 #include <QHBoxLayout>
 
@@ -76,19 +77,23 @@ void ScalarSourceAction::updateScalarRange()
     const auto hasScalarRange = points.isValid() && _pickerAction.getCurrentIndex() >= 1;
 
     if (hasScalarRange) {
-        minimum = std::numeric_limits<float>::max();
-        maximum = std::numeric_limits<float>::lowest();
-
-        points->visitData([this, &minimum, &maximum, points](auto pointData) {
-            const auto currentDimensionIndex = _dimensionPickerAction.getCurrentDimensionIndex();
-
-            for (std::uint32_t pointIndex = 0; pointIndex < points->getNumPoints(); pointIndex++) {
-                auto pointValue = static_cast<float>(pointData[pointIndex][currentDimensionIndex]);
-                
-                minimum = std::min(minimum, pointValue);
-                maximum = std::max(maximum, pointValue);
-            }
-        });
+        const auto currentDimensionIndex = _dimensionPickerAction.getCurrentDimensionIndex();
+
+        ColumnStatistics statistics;
+
+        // Re-picking a dimension does not rescan its column
+        if (auto scatterplotPlugin = dynamic_cast<ScatterplotPlugin*>(findPluginAncestor()))
+            statistics = scatterplotPlugin->getColumnStatisticsCache().getStatistics(points, currentDimensionIndex);
+        else
+            statistics = ColumnStatisticsCache::computeStatistics(points, currentDimensionIndex);
+
+        if (statistics.getNumberOfNonFiniteValues() > 0)
+            qDebug() << "ScalarSourceAction: excluded" << statistics.getNumberOfNonFiniteValues() << "non-finite values from the scalar range of" << points->getGuiName();
+
+        if (statistics.hasFiniteValues()) {
+            minimum = statistics._minimum;
+            maximum = statistics._maximum;
+        }
     }
 
     _rangeAction.getRangeMinAction().initialize(minimum, maximum, minimum, 1);
@@ -1,7 +1,11 @@
 #include "ScatterplotPlugin.h"
 
+#include "ColumnView.h"
 #include "MappingUtils.h"
+#include "ParallelUtils.h"
 #include "ScatterplotWidget.h"
+#include "SelectionKernel.h"
+#include "SelectionMerge.h"
 
 #include <Application.h>
 #include <DataHierarchyItem.h>
@@ -33,9 +37,11 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <exception>
 #include <map>
 #include <stdexcept>
+#include <string>
 #include <vector>
 
 #define VIEW_SAMPLING_HTML
@@ -46,13 +52,35 @@ Q_PLUGIN_METADATA(IID "studio.manivault.ScatterplotPlugin")
 using namespace mv;
 using namespace mv::util;
 
+namespace
+{
+    // Signature of the point indices of a cluster, used to tell whether the indices of a cluster were edited in place
+    std::uint64_t computeClusterSignature(const Cluster& cluster)
+    {
+        const auto& indices = cluster.getIndices();
+
+        std::uint64_t signature = indices.size();
+
+        for (const auto& index : indices)
+            signature = signature * 1'000'003 + index;
+
+        return signature;
+    }
+}
+
 ScatterplotPlugin::ScatterplotPlugin(const PluginFactory* factory) :
     ViewPlugin(factory),
     _dropWidget(nullptr),
     _scatterPlotWidget(new ScatterplotWidget(this)),
     _numPoints(0),
+    _selectionPublisher(this),
+    _positionsExtractor(this),
+    _columnStatisticsCache(this),
+    _mappingCompatibilityCache(this),
     _settingsAction(new SettingsAction(this, "Settings")),
-    _primaryToolbarAction(new HorizontalToolbarAction(this, "Primary Toolbar"))
+    _primaryToolbarAction(new HorizontalToolbarAction(this, "Primary Toolbar")),
+    _colorMapping(),
+    _clusterLabels()
 {
     setObjectName("Scatterplot");
 
@@ -187,16 +215,17 @@ ScatterplotPlugin::ScatterplotPlugin(const PluginFactory* factory) :
                 //      b) from color to position (or it's parent)
                 //      c) from source of position to color
 
+                // The checks are cached per dataset pair, since this is evaluated on every drag hover
+                const auto compatibility = _mappingCompatibilityCache.getCompatibility(candidateDataset, _positionDataset);
+
                 // [1. Same number of points]
-                const auto numPointsCandidate   = candidateDataset->getNumPoints();
-                const auto numPointsPosition    = _positionDataset->getNumPoints();
-                const bool hasSameNumPoints     = numPointsPosition == numPointsCandidate;
+                const bool hasSameNumPoints     = compatibility._hasSameNumPoints;
 
                 // [2. Derived from a parent]
-                const bool hasSameNumPointsAsFull = fullSourceHasSameNumPoints(_positionDataset, candidateDataset);
+                const bool hasSameNumPointsAsFull = compatibility._hasSameNumPointsAsFull;
 
                 // [3. Full selection mapping]
-                const bool hasSelectionMapping  = checkSelectionMapping(candidateDataset, _positionDataset);
+                const bool hasSelectionMapping  = compatibility._hasSelectionMapping;
 
                 if (hasSameNumPoints || hasSameNumPointsAsFull || hasSelectionMapping) {
                     // Offer the option to use the points dataset as source for points colors
@@ -336,14 +365,67 @@ void ScatterplotPlugin::init()
         selectPoints();
     });
 
+    connect(&_scatterPlotWidget->getPixelSelectionTool(), &PixelSelectionTool::started, this, [this]() -> void {
+        _incrementalSelection.end();
+        _selectionPublisher.beginStroke();
+    });
+
+    // Publishes the final selection of the stroke (after the selection above)
+    connect(&_scatterPlotWidget->getPixelSelectionTool(), &PixelSelectionTool::ended, this, [this]() -> void {
+        _incrementalSelection.end();
+        _selectionPublisher.endStroke();
+    });
+
     connect(&getSamplerAction(), &ViewPluginSamplerAction::sampleContextRequested, this, &ScatterplotPlugin::samplePoints);
 
     connect(&_positionDataset, &Dataset<Points>::changed, this, &ScatterplotPlugin::positionDatasetChanged);
     connect(&_positionDataset, &Dataset<Points>::dataChanged, this, [this]() -> void {
+        _indexMapping.invalidate();
+        _colorMapping._isValid = false;
+        _clusterLabels._isValid = false;
+
         updateData();
         updateHeadsUpDisplay();
     });
     connect(&_positionDataset, &Dataset<Points>::dataSelectionChanged, this, &ScatterplotPlugin::updateSelection);
+
+    // The color mapping follows the strategy of the compatibility cache, which drops it when any involved dataset changes
+    connect(&_mappingCompatibilityCache, &MappingCompatibilityCache::entryDropped, this, [this](const QString& colorsDatasetId, const QString& positionsDatasetId) -> void {
+        if (colorsDatasetId == _colorMapping._colorDatasetId && positionsDatasetId == _colorMapping._positionDatasetId)
+            _colorMapping._isValid = false;
+    });
+
+    // Indices edited in place keep the identifiers and sizes of the clusters, so they are only looked for when the clusters signal a data
+    // change (also for name and color changes), which may reach the coloring before this connection
+    connect(&_clusterLabels._clusters, &Dataset<Clusters>::dataChanged, this, [this]() -> void {
+        if (!_clusterLabels._isValid || !_clusterLabels._clusters.isValid())
+            return;
+
+        const auto& clusterVec          = _clusterLabels._clusters->getClusters();
+        const auto& labeledClusters     = _clusterLabels._labeledClusters;
+        const auto  numberOfClusters    = std::min(labeledClusters.size(), static_cast<std::size_t>(clusterVec.size()));
+
+        for (std::size_t clusterIndex = 0; clusterIndex < numberOfClusters; clusterIndex++) {
+            if (labeledClusters[clusterIndex]._signature == computeClusterSignature(clusterVec[clusterIndex]))
+                continue;
+
+            _clusterLabels._isValid = false;
+
+            auto& coloringAction = _settingsAction->getColoringAction();
+
+            const auto currentColorDataset = coloringAction.getCurrentColorDataset();
+
+            if (coloringAction.getColorByAction().getCurrentIndex() > 1 && currentColorDataset.isValid() && currentColorDataset->getId() == _clusterLabels._clusters->getId())
+                loadColors(_clusterLabels._clusters);
+
+            return;
+        }
+    });
+
+    connect(&_positionsExtractor, &PositionsExtractor::finished, this, [this]() -> void {
+        if (_positionDataset.isValid())
+            setPositions(_positionsExtractor.takeResult());
+    });
     connect(&_positionDataset, &Dataset<>::guiNameChanged, this, &ScatterplotPlugin::updateHeadsUpDisplay);
 
     connect(&_settingsAction->getMiscellaneousAction().getBackgroundColorAction(), &ColorAction::colorChanged, this, &ScatterplotPlugin::updateHeadsUpDisplayTextColor);
@@ -471,56 +553,45 @@ void ScatterplotPlugin::selectPoints()
     if (!_positionDataset.isValid() || !pixelSelectionTool.isActive() || navigator.isNavigating() || !pixelSelectionTool.isEnabled())
         return;
 
-    auto selectionAreaImage = pixelSelectionTool.getAreaPixmap().toImage();
-    auto selectionSet       = _positionDataset->getSelection<Points>();
-
-    std::vector<std::uint32_t> targetSelectionIndices;
+    const auto zoomRectangleWorld   = navigator.getZoomRectangleWorld();
+    const auto screenRectangle      = QRect(QPoint(), renderer->getRenderSize());
+    const auto selectionMask        = SelectionMask(pixelSelectionTool.getAreaPixmap().toImage(), screenRectangle);
+    const auto screenProjection     = ScreenProjection(zoomRectangleWorld, screenRectangle.size());
 
-    targetSelectionIndices.reserve(_positionDataset->getNumPoints());
+    const auto isIncremental = getSettingsAction().getSelectionAction().getIncrementalAction().isChecked() && pixelSelectionTool.isNotifyDuringSelection() && !pixelSelectionTool.isAborted() && (pixelSelectionTool.getType() == PixelSelectionType::Brush || pixelSelectionTool.getType() == PixelSelectionType::Lasso);
 
-    std::vector<std::uint32_t> localGlobalIndices;
+    SelectionKernel::Result selection;
 
-    _positionDataset->getGlobalIndices(localGlobalIndices);
+    if (isIncremental) {
+        const auto isStrokeStart = !_incrementalSelection.isActive();
 
-    const auto zoomRectangleWorld   = navigator.getZoomRectangleWorld();
-    const auto screenRectangle      = QRect(QPoint(), renderer->getRenderSize());
+        // Only test the points under the pixels which changed since the previous update, and do not publish when no point entered or left the stroke area
+        if (!_incrementalSelection.update(_positions, _spatialIndex, selectionMask, screenProjection) && !isStrokeStart)
+            return;
 
-    float boundaries[4]{
-        std::numeric_limits<float>::max(),
-        std::numeric_limits<float>::lowest(),
-        std::numeric_limits<float>::max(),
-        std::numeric_limits<float>::lowest()
-    };
+        selection._localIndices = _incrementalSelection.getLocalIndices(_positions, selection._bounds);
+    }
+    else {
+        _incrementalSelection.end();
 
-    // Go over all points in the dataset to see if they are selected
-    for (std::uint32_t localPointIndex = 0; localPointIndex < _positions.size(); localPointIndex++) {
-	    const auto& point = _positions[localPointIndex];
+        // Only test the points under the selection area, spread over the available threads
+        selection = SelectionKernel(_positions, selectionMask, screenProjection).select(_spatialIndex);
+    }
 
-    	// Compute the offset of the point in the world space
-    	const auto pointOffsetWorld = QPointF(point.x - zoomRectangleWorld.left(), point.y - zoomRectangleWorld.top());
+    auto selectionSet = _positionDataset->getSelection<Points>();
 
-    	// Normalize it 
-    	const auto pointOffsetWorldNormalized = QPointF(pointOffsetWorld.x() / zoomRectangleWorld.width(), pointOffsetWorld.y() / zoomRectangleWorld.height());
+    std::vector<std::uint32_t> targetSelectionIndices;
 
-    	// Convert it to screen space
-    	const auto pointOffsetScreen = QPoint(pointOffsetWorldNormalized.x() * screenRectangle.width(), screenRectangle.height() - pointOffsetWorldNormalized.y() * screenRectangle.height());
+    const auto& indexMapping = getIndexMapping();
 
-    	// Continue to next point if the point is outside the screen
-    	if (!screenRectangle.contains(pointOffsetScreen))
-    		continue;
+    targetSelectionIndices.reserve(selection._localIndices.size());
 
-    	// If the corresponding pixel is not transparent, add the point to the selection
-    	if (selectionAreaImage.pixelColor(pointOffsetScreen).alpha() > 0) {
-    		targetSelectionIndices.push_back(localGlobalIndices[localPointIndex]);
+    for (const auto localPointIndex : selection._localIndices)
+        targetSelectionIndices.push_back(indexMapping.getGlobalIndex(localPointIndex));
 
-            boundaries[0] = std::min(boundaries[0], point.x);
-            boundaries[1] = std::max(boundaries[1], point.x);
-            boundaries[2] = std::min(boundaries[2], point.y);
-            boundaries[3] = std::max(boundaries[3], point.y);
-	    }
-    }
+    const auto& boundaries = selection._bounds;
 
-    _selectionBoundaries = QRectF(boundaries[0], boundaries[2], boundaries[1] - boundaries[0], boundaries[3] - boundaries[2]);
+    _selectionBoundaries = QRectF(boundaries._left, boundaries._bottom, boundaries._right - boundaries._left, boundaries._top - boundaries._bottom);
 
     switch (const auto selectionModifier = pixelSelectionTool.isAborted() ? PixelSelectionModifierType::Subtract : pixelSelectionTool.getModifier())
     {
@@ -530,39 +601,8 @@ void ScatterplotPlugin::selectPoints()
         case PixelSelectionModifierType::Add:
         case PixelSelectionModifierType::Subtract:
         {
-            // Get reference to the indices of the selection set
-            auto& selectionSetIndices = selectionSet->indices;
-
-            // Create a set from the selection set indices
-            QSet<std::uint32_t> set(selectionSetIndices.begin(), selectionSetIndices.end());
-
-            switch (selectionModifier)
-            {
-                // Add points to the current selection
-                case PixelSelectionModifierType::Add:
-                {
-                    // Add indices to the set 
-                    for (const auto& targetIndex : targetSelectionIndices)
-                        set.insert(targetIndex);
-
-                    break;
-                }
-
-                // Remove points from the current selection
-                case PixelSelectionModifierType::Subtract:
-                {
-                    // Remove indices from the set 
-                    for (const auto& targetIndex : targetSelectionIndices)
-                        set.remove(targetIndex);
-
-                    break;
-                }
-
-                case PixelSelectionModifierType::Replace:
-                    break;
-            }
-
-            targetSelectionIndices = std::vector<std::uint32_t>(set.begin(), set.end());
+            // Merge with the indices of the selection set, or the selection which is yet to be published (sorted, using a bitset for large selections and a sorted merge otherwise)
+            targetSelectionIndices = mergeSelectionIndices(_selectionPublisher.hasPendingSelection() ? _selectionPublisher.getPendingSelectionIndices() : selectionSet->indices, targetSelectionIndices, selectionModifier == PixelSelectionModifierType::Add ? SelectionMergeOperation::Add : SelectionMergeOperation::Subtract);
 
             break;
         }
@@ -572,9 +612,8 @@ void ScatterplotPlugin::selectPoints()
 
     navigationAction.getZoomSelectionAction().setEnabled(!targetSelectionIndices.empty() && navigationAction.isNavigationActive());
 
-    _positionDataset->setSelectionIndices(targetSelectionIndices);
-
-    events().notifyDatasetDataSelectionChanged(_positionDataset->getSourceDataset<Points>());
+    // Coalesced with other selections of the stroke in progress
+    _selectionPublisher.publish(_positionDataset, std::move(targetSelectionIndices));
 }
 
 void ScatterplotPlugin::samplePoints()
@@ -584,19 +623,7 @@ void ScatterplotPlugin::samplePoints()
     if (!_positionDataset.isValid() || _scatterPlotWidget->_pointRenderer.getNavigator().isNavigating() || !samplerPixelSelectionTool.isActive())
         return;
 
-    auto selectionAreaImage = samplerPixelSelectionTool.getAreaPixmap().toImage();
-
-    std::vector<std::uint32_t> targetSelectionIndices;
-
-    targetSelectionIndices.reserve(_positionDataset->getNumPoints());
-
-    std::vector<std::uint32_t> localGlobalIndices;
-
-    _positionDataset->getGlobalIndices(localGlobalIndices);
-    
-    std::vector<char> focusHighlights(_positions.size());
-
-    std::vector<std::pair<float, std::uint32_t>> sampledPoints;
+    const auto& indexMapping = getIndexMapping();
 
     auto& pointRenderer = _scatterPlotWidget->_pointRenderer;
     auto& navigator     = pointRenderer.getNavigator();
@@ -604,62 +631,64 @@ void ScatterplotPlugin::samplePoints()
     const auto zoomRectangleWorld   = navigator.getZoomRectangleWorld();
     const auto screenRectangle      = QRect(QPoint(), pointRenderer.getRenderSize());
     const auto mousePositionWorld   = pointRenderer.getScreenPointToWorldPosition(pointRenderer.getNavigator().getViewMatrix(), _scatterPlotWidget->mapFromGlobal(QCursor::pos()));
+    const auto screenProjection     = ScreenProjection(zoomRectangleWorld, screenRectangle.size());
+    const auto mousePosition        = mv::Vector2f(mousePositionWorld.x(), mousePositionWorld.y());
+    const auto mouseScreenX         = screenProjection.getScreenX(mousePosition.x);
+    const auto mouseScreenY         = screenProjection.getScreenY(mousePosition.y);
+    const auto brushRadius          = samplerPixelSelectionTool.getBrushRadius();
 
-    // Go over all points in the dataset to see if they should be sampled
-    for (std::uint32_t localPointIndex = 0; localPointIndex < _positions.size(); localPointIndex++) {
+    const auto restrictNumberOfElements = getSamplerAction().getRestrictNumberOfElementsAction().isChecked();
+    const auto maximumNumberOfElements  = static_cast<std::size_t>(std::max(0, getSamplerAction().getMaximumNumberOfElementsAction().getValue()));
 
-        // Compute the offset of the point in the world space
-        const auto pointOffsetWorld = QPointF(_positions[localPointIndex].x - zoomRectangleWorld.left(), _positions[localPointIndex].y - zoomRectangleWorld.top());
+    // The sampler is a disk of the brush radius around the mouse, so points are tested against the disk instead of against a mask of the sampler area
+    const auto brushRectangle = QRect(static_cast<int>(mouseScreenX - brushRadius), static_cast<int>(mouseScreenY - brushRadius), static_cast<int>(2.0f * brushRadius) + 2, static_cast<int>(2.0f * brushRadius) + 2).intersected(screenRectangle);
 
-        // Normalize it 
-        const auto pointOffsetWorldNormalized = QPointF(pointOffsetWorld.x() / zoomRectangleWorld.width(), pointOffsetWorld.y() / zoomRectangleWorld.height());
+    std::vector<SpatialIndex::Neighbour> sampledPoints;
 
-        // Convert it to screen space
-        const auto pointOffsetScreen = QPoint(pointOffsetWorldNormalized.x() * screenRectangle.width(), screenRectangle.height() - pointOffsetWorldNormalized.y() * screenRectangle.height());
+    if (!brushRectangle.isEmpty()) {
+        const auto samplerRectangleWorld = screenProjection.getWorldRectangle(brushRectangle);
 
-        // Continue to next point if the point is outside the screen
-        if (!screenRectangle.contains(pointOffsetScreen))
-            continue;
+        // No point of the disk is farther away from the mouse than the farthest corner of its bounding rectangle
+        const auto maximumDistance = std::hypot(std::max(std::abs(samplerRectangleWorld._left - mousePosition.x), std::abs(samplerRectangleWorld._right - mousePosition.x)), std::max(std::abs(samplerRectangleWorld._bottom - mousePosition.y), std::abs(samplerRectangleWorld._top - mousePosition.y)));
 
-        // If the corresponding pixel is not transparent, add the point to the selection
-        if (selectionAreaImage.pixelColor(pointOffsetScreen).alpha() > 0) {
-            const auto sample = std::pair((QVector2D(_positions[localPointIndex].x, _positions[localPointIndex].y) - mousePositionWorld.toVector2D()).length(), localPointIndex);
+        // Search outwards from the mouse position for the nearest (visible) points in the disk
+        sampledPoints = _spatialIndex.getNearestPoints(_positions, mousePosition, restrictNumberOfElements ? maximumNumberOfElements : _positions.size(), maximumDistance, [this, &screenProjection, &screenRectangle, mouseScreenX, mouseScreenY, brushRadius](std::uint32_t localPointIndex) -> bool {
+            const auto& position = _positions[localPointIndex];
 
-            sampledPoints.emplace_back(sample);
-        }
+            const auto screenX = screenProjection.getScreenX(position.x);
+            const auto screenY = screenProjection.getScreenY(position.y);
+
+            if (!screenRectangle.contains(static_cast<int>(screenX), static_cast<int>(screenY)))
+                return false;
+
+            return (screenX - mouseScreenX) * (screenX - mouseScreenX) + (screenY - mouseScreenY) * (screenY - mouseScreenY) <= brushRadius * brushRadius;
+        });
     }
-    
+
     QVariantList localPointIndices, globalPointIndices, distances;
 
     localPointIndices.reserve(static_cast<std::int32_t>(sampledPoints.size()));
     globalPointIndices.reserve(static_cast<std::int32_t>(sampledPoints.size()));
     distances.reserve(static_cast<std::int32_t>(sampledPoints.size()));
 
-    std::int32_t numberOfPoints = 0;
+    std::vector<std::uint32_t> focusedLocalIndices;
 
-    std::sort(sampledPoints.begin(), sampledPoints.end(), [](const auto& sampleA, const auto& sampleB) -> bool {
-        return sampleB.first > sampleA.first;
-    });
+    focusedLocalIndices.reserve(sampledPoints.size());
 
     for (const auto& sampledPoint : sampledPoints) {
-        if (getSamplerAction().getRestrictNumberOfElementsAction().isChecked() && numberOfPoints >= getSamplerAction().getMaximumNumberOfElementsAction().getValue())
-            break;
-
-        const auto& distance            = sampledPoint.first;
-        const auto& localPointIndex     = sampledPoint.second;
-        const auto& globalPointIndex    = localGlobalIndices[localPointIndex];
+        const auto& distance            = sampledPoint._distance;
+        const auto& localPointIndex     = sampledPoint._localIndex;
+        const auto& globalPointIndex    = indexMapping.getGlobalIndex(localPointIndex);
 
         distances << distance;
         localPointIndices << localPointIndex;
         globalPointIndices << globalPointIndex;
 
-        focusHighlights[localPointIndex] = true;
-
-        numberOfPoints++;
+        focusedLocalIndices.push_back(localPointIndex);
     }
 
     if (getSamplerAction().getHighlightFocusedElementsAction().isChecked())
-        const_cast<PointRenderer&>(_scatterPlotWidget->getPointRenderer()).setFocusHighlights(focusHighlights, static_cast<std::int32_t>(focusHighlights.size()));
+        updateFocusHighlights(std::move(focusedLocalIndices));
 
     _scatterPlotWidget->update();
 
@@ -680,6 +709,30 @@ void ScatterplotPlugin::samplePoints()
     });
 }
 
+void ScatterplotPlugin::updateFocusHighlights(std::vector<std::uint32_t> focusedLocalIndices)
+{
+    std::sort(focusedLocalIndices.begin(), focusedLocalIndices.end());
+
+    if (_focusHighlights.size() != _positions.size()) {
+        _focusHighlights.assign(_positions.size(), 0);
+        _focusedLocalIndices.clear();
+    }
+    else if (focusedLocalIndices == _focusedLocalIndices) {
+        return;
+    }
+
+    // Only the previously and the newly focused points change
+    for (const auto localPointIndex : _focusedLocalIndices)
+        _focusHighlights[localPointIndex] = 0;
+
+    for (const auto localPointIndex : focusedLocalIndices)
+        _focusHighlights[localPointIndex] = 1;
+
+    _focusedLocalIndices = std::move(focusedLocalIndices);
+
+    const_cast<PointRenderer&>(_scatterPlotWidget->getPointRenderer()).setFocusHighlights(_focusHighlights, static_cast<std::int32_t>(_focusHighlights.size()));
+}
+
 Dataset<Points>& ScatterplotPlugin::getPositionDataset()
 {
     return _positionDataset;
@@ -690,8 +743,18 @@ Dataset<Points>& ScatterplotPlugin::getPositionSourceDataset()
     return _positionSourceDataset;
 }
 
+const IndexMapping& ScatterplotPlugin::getIndexMapping()
+{
+    if (_positionDataset.isValid() && (!_indexMapping.isValid() || _indexMapping.getNumberOfPoints() != _positionDataset->getNumPoints()))
+        _indexMapping.update(_positionDataset);
+
+    return _indexMapping;
+}
+
 void ScatterplotPlugin::positionDatasetChanged()
 {
+    _indexMapping.invalidate();
+
     _dropWidget->setShowDropIndicator(!_positionDataset.isValid());
     _scatterPlotWidget->getPixelSelectionTool().setEnabled(_positionDataset.isValid());
 
@@ -714,119 +777,192 @@ void ScatterplotPlugin::positionDatasetChanged()
 }
 
 bool ScatterplotPlugin::mapColorScalars(const Dataset<Points>& pointsColor, const std::uint32_t& dimensionIndex, std::vector<float>& colorScalars)
+{
+    std::vector<std::vector<float>> mappedColorScalars;
+
+    if (!mapColorScalars(pointsColor, { dimensionIndex }, mappedColorScalars))
+        return false;
+
+    std::swap(mappedColorScalars.front(), colorScalars);
+
+    return true;
+}
+
+bool ScatterplotPlugin::mapColorScalars(const Dataset<Points>& pointsColor, const std::vector<std::uint32_t>& dimensionIndices, std::vector<std::vector<float>>& colorScalars)
 {
     // Only proceed with valid points dataset
     if (!pointsColor.isValid())
         return false;
 
-    const auto numColorPoints = pointsColor->getNumPoints();
+    const auto colorMapping = getColorMapping(pointsColor);
+
+    if (colorMapping == nullptr)
+        return false;
+
+    const auto& colorIndices = *colorMapping;
+
+    // Generate point colorScalars for color mapping (all dimensions in one pass over the color data)
+    if (!extractColumns(*pointsColor, std::vector<std::int32_t>(dimensionIndices.begin(), dimensionIndices.end()), colorScalars)) {
+        qDebug() << "ScatterplotPlugin::mapColorScalars: dimension index out of range";
+        return false;
+    }
+
+    // If number of points do not match, gather the color scalars of all dimensions through the mapping
+    if (!colorIndices.empty()) {
+        std::vector<std::vector<float>> mappedColorScalars(colorScalars.size(), std::vector<float>(_numPoints));
+
+        forEachChunk(_numPoints, getNumberOfChunks(_numPoints, COLUMN_EXTRACTION_MINIMUM_CHUNK_SIZE), [&colorIndices, &colorScalars, &mappedColorScalars](std::size_t chunkIndex, std::size_t begin, std::size_t end) -> void {
+            for (std::size_t channelIndex = 0; channelIndex < colorScalars.size(); channelIndex++) {
+                const auto& channelScalars  = colorScalars[channelIndex];
+                auto& mappedChannelScalars  = mappedColorScalars[channelIndex];
+
+                for (std::size_t localIndex = begin; localIndex < end; localIndex++) {
+                    const auto colorIndex = colorIndices[localIndex];
+
+                    mappedChannelScalars[localIndex] = colorIndex == UNMAPPED_COLOR_INDEX ? std::numeric_limits<float>::lowest() : channelScalars[colorIndex];
+                }
+            }
+        });
+
+        std::swap(mappedColorScalars, colorScalars);
+    }
+
+    for (const auto& channelScalars : colorScalars)
+        assert(channelScalars.size() == _numPoints);
+
+    return true;
+}
+
+const std::vector<std::uint32_t>* ScatterplotPlugin::getColorMapping(const Dataset<Points>& pointsColor)
+{
+    if (!_positionDataset.isValid())
+        return nullptr;
+
+    const auto isCurrent =
+        _colorMapping._isValid &&
+        _colorMapping._colorDatasetId == pointsColor->getId() &&
+        _colorMapping._positionDatasetId == _positionDataset->getId() &&
+        _colorMapping._numberOfColorPoints == pointsColor->getNumPoints() &&
+        _colorMapping._numberOfPositionPoints == _numPoints;
 
-    // Generate point colorScalars for color mapping
-    colorScalars.clear();
-    pointsColor->extractDataForDimension(colorScalars, dimensionIndex);
+    if (isCurrent)
+        return &_colorMapping._colorIndices;
+
+    _colorMapping._isValid = false;
+
+    if (!computeColorMapping(pointsColor, _colorMapping._colorIndices))
+        return nullptr;
+
+    _colorMapping._colorDatasetId           = pointsColor->getId();
+    _colorMapping._positionDatasetId        = _positionDataset->getId();
+    _colorMapping._numberOfColorPoints      = pointsColor->getNumPoints();
+    _colorMapping._numberOfPositionPoints   = _numPoints;
+    _colorMapping._isValid                  = true;
+
+    return &_colorMapping._colorIndices;
+}
+
+bool ScatterplotPlugin::computeColorMapping(const Dataset<Points>& pointsColor, std::vector<std::uint32_t>& colorIndices)
+{
+    colorIndices.clear();
+
+    const auto numColorPoints = pointsColor->getNumPoints();
 
     // If number of points do not match, use a mapping
     // prefer global IDs (for derived data) over selection mapping
     // prefer color to position over position to color over source of position to color
-    if (numColorPoints != _numPoints) {
+    if (numColorPoints == _numPoints)
+        return true;
 
-        std::vector<float> mappedColorScalars(_numPoints, std::numeric_limits<float>::lowest());
+    colorIndices.resize(_numPoints, UNMAPPED_COLOR_INDEX);
 
-        try {
-            const bool hasSameNumPointsAsFull = fullSourceHasSameNumPoints(_positionDataset, pointsColor);
+    // The strategy (including the surjectivity check of the selection mapping) is resolved once per dataset pair
+    const auto strategy = _mappingCompatibilityCache.getStrategy(pointsColor, _positionDataset);
 
-            if (hasSameNumPointsAsFull) {
-                std::vector<std::uint32_t> globalIndices = {};
-                _positionDataset->getGlobalIndices(globalIndices);
+    try {
+        if (strategy == MappingCompatibilityCache::Strategy::GlobalIndices) {
+            const auto& globalIndices = getIndexMapping().getGlobalIndices();
 
-                for (std::int32_t localIndex = 0; localIndex < globalIndices.size(); localIndex++) {
-                    mappedColorScalars[localIndex] = colorScalars[globalIndices[localIndex]];
-                }
+            std::copy(globalIndices.begin(), globalIndices.end(), colorIndices.begin());
+        }
+        else if (strategy == MappingCompatibilityCache::Strategy::ColorsToPositions) {
+            // mapping from color data set to position data set
+            const auto [selectionMapping, numPointsTarget] = getSelectionMappingColorsToPositions(pointsColor, _positionDataset);
 
-            }
-            else if ( // mapping from color data set to position data set
-                const auto [selectionMapping, numPointsTarget] = getSelectionMappingColorsToPositions(pointsColor, _positionDataset);
-                /* check if valid */ 
-                selectionMapping != nullptr && 
-                numPointsTarget == _numPoints &&
-                checkSurjectiveMapping(*selectionMapping, numPointsTarget)
-                )
-            {
-                // Map values like selection
-                const mv::SelectionMap::Map& mapColorsToPositions = selectionMapping->getMapping().getMap();
+            if (selectionMapping == nullptr)
+                throw std::runtime_error("Selection mapping is no longer available");
 
-                for (const auto& [fromColorID, vecOfPositionIDs] : mapColorsToPositions) {
-                    for (const std::uint32_t toPositionID : vecOfPositionIDs) {
-                        mappedColorScalars[toPositionID] = colorScalars[fromColorID];
-                    }
-                }
+            // Map values like selection
+            const mv::SelectionMap::Map& mapColorsToPositions = selectionMapping->getMapping().getMap();
 
-            }
-            else if ( // mapping from position data set to color data set 
-                const auto [selectionMapping, numPointsTarget] = getSelectionMappingPositionsToColors(_positionDataset, pointsColor);
-                /* check if valid */ 
-                selectionMapping != nullptr &&
-                numPointsTarget == numColorPoints &&
-                checkSurjectiveMapping(*selectionMapping, numPointsTarget)
-                )
-            {
-                // Map values like selection (in reverse, use first value that occurs)
-                const mv::SelectionMap::Map& mapPositionsToColors = selectionMapping->getMapping().getMap();
-
-                for (const auto& [fromPositionID, vecOfColorIDs] : mapPositionsToColors) {
-                    if (mappedColorScalars[fromPositionID] != std::numeric_limits<float>::lowest())
-                        continue;
-                    for (const std::uint32_t toColorID : vecOfColorIDs) {
-                        mappedColorScalars[fromPositionID] = colorScalars[toColorID];
-                    }
+            for (const auto& [fromColorID, vecOfPositionIDs] : mapColorsToPositions) {
+                for (const std::uint32_t toPositionID : vecOfPositionIDs) {
+                    colorIndices[toPositionID] = fromColorID;
                 }
-
             }
-            else if ( // mapping from source of position data set to color data set 
-                const auto [selectionMapping, numPointsTarget] = getSelectionMappingPositionSourceToColors(_positionDataset, pointsColor);
-                /* check if valid */ 
-                selectionMapping != nullptr && 
-                numPointsTarget == numColorPoints &&
-                checkSurjectiveMapping(*selectionMapping, numPointsTarget)
-                )
-            {
-                // the selection map is from full source data of positions data to pointsColor
-                // we need to use both the global indices of the positions (i.e. in the source) and the linked data mapping
-                const mv::SelectionMap::Map& mapGlobalToColors = selectionMapping->getMapping().getMap();
-                std::vector<std::uint32_t> globalIndices = {};
-                _positionDataset->getGlobalIndices(globalIndices);
 
-                for (std::int32_t localIndex = 0; localIndex < globalIndices.size(); localIndex++) {
+        }
+        else if (strategy == MappingCompatibilityCache::Strategy::PositionsToColors) {
+            // mapping from position data set to color data set
+            const auto [selectionMapping, numPointsTarget] = getSelectionMappingPositionsToColors(_positionDataset, pointsColor);
 
-                    if (mappedColorScalars[localIndex] != std::numeric_limits<float>::lowest())
-                        continue;
+            if (selectionMapping == nullptr)
+                throw std::runtime_error("Selection mapping is no longer available");
 
-                    const auto& indxColors = mapGlobalToColors.at(globalIndices[localIndex]);   // from full source (parent) to colorDataset
+            // Map values like selection (in reverse, use first value that occurs)
+            const mv::SelectionMap::Map& mapPositionsToColors = selectionMapping->getMapping().getMap();
 
-                    for (const auto& indColors : indxColors) {
-                        mappedColorScalars[localIndex] = colorScalars[indColors];
-                    }
-                }
+            for (const auto& [fromPositionID, vecOfColorIDs] : mapPositionsToColors) {
+                if (colorIndices[fromPositionID] != UNMAPPED_COLOR_INDEX || vecOfColorIDs.empty())
+                    continue;
 
-            }
-            else {
-                throw std::runtime_error("Coloring data set does not match position data set in a known way, aborting attempt to color plot");
+                colorIndices[fromPositionID] = vecOfColorIDs.back();
             }
 
         }
-        catch (const std::exception& e) {
-            qDebug() << "ScatterplotPlugin::mapColorScalars: mapping failed -> " << e.what();
-            return false;
+        else if (strategy == MappingCompatibilityCache::Strategy::PositionSourceToColors) {
+            // mapping from source of position data set to color data set
+            const auto [selectionMapping, numPointsTarget] = getSelectionMappingPositionSourceToColors(_positionDataset, pointsColor);
+
+            if (selectionMapping == nullptr)
+                throw std::runtime_error("Selection mapping is no longer available");
+
+            // the selection map is from full source data of positions data to pointsColor
+            // we need to use both the global indices of the positions (i.e. in the source) and the linked data mapping
+            const mv::SelectionMap::Map& mapGlobalToColors = selectionMapping->getMapping().getMap();
+            const auto& globalIndices = getIndexMapping().getGlobalIndices();
+
+            // Flatten the mapping into a dense global index to color index table in one ordered walk, instead of a tree lookup per point
+            constexpr auto missingGlobalIndex = UNMAPPED_COLOR_INDEX - 1;
+
+            std::vector<std::uint32_t> globalToColorIndices(mapGlobalToColors.empty() ? 0 : mapGlobalToColors.rbegin()->first + 1, missingGlobalIndex);
+
+            for (const auto& [globalIndex, indxColors] : mapGlobalToColors)
+                globalToColorIndices[globalIndex] = indxColors.empty() ? UNMAPPED_COLOR_INDEX : indxColors.back();
+
+            for (std::size_t localIndex = 0; localIndex < globalIndices.size(); localIndex++) {
+                const auto globalIndex = globalIndices[localIndex];
+
+                if (globalIndex >= globalToColorIndices.size() || globalToColorIndices[globalIndex] == missingGlobalIndex)
+                    throw std::out_of_range("Point " + std::to_string(globalIndex) + " of the position source is not mapped to the coloring data set");
+
+                colorIndices[localIndex] = globalToColorIndices[globalIndex];
+            }
+
         }
-        catch (...) {
-            qDebug() << "ScatterplotPlugin::mapColorScalars: mapping failed for an unknown reason.";
-            return false;
+        else {
+            throw std::runtime_error("Coloring data set does not match position data set in a known way, aborting attempt to color plot");
         }
 
-        std::swap(mappedColorScalars, colorScalars);
     }
-
-    assert(colorScalars.size() == _numPoints);
+    catch (const std::exception& e) {
+        qDebug() << "ScatterplotPlugin::computeColorMapping: mapping failed -> " << e.what();
+        return false;
+    }
+    catch (...) {
+        qDebug() << "ScatterplotPlugin::computeColorMapping: mapping failed for an unknown reason.";
+        return false;
+    }
 
     return true;
 }
@@ -852,18 +988,16 @@ void ScatterplotPlugin::loadColors(const Dataset<Points>& pointsColor, const std
 
 void ScatterplotPlugin::loadColors2D(const Dataset<Points>& pointsColor, const std::uint32_t& dimensionIndexX, const std::uint32_t& dimensionIndexY)
 {
-    std::vector<float> colorScalarsX = {};
-    std::vector<float> colorScalarsY = {};
+    std::vector<std::vector<float>> colorScalars = {};
 
-    if (!mapColorScalars(pointsColor, dimensionIndexX, colorScalarsX) ||
-        !mapColorScalars(pointsColor, dimensionIndexY, colorScalarsY)) {
+    if (!mapColorScalars(pointsColor, { dimensionIndexX, dimensionIndexY }, colorScalars)) {
         _settingsAction->getColoringAction().getColorByAction().setCurrentIndex(0);  // reset to color by constant
         return;
     }
 
     // Assign both channels and the two-channel 2D coloring effect
-    _scatterPlotWidget->setScalars(colorScalarsX);
-    _scatterPlotWidget->setScalars2(colorScalarsY);
+    _scatterPlotWidget->setScalars(colorScalars[0]);
+    _scatterPlotWidget->setScalars2(colorScalars[1]);
     _scatterPlotWidget->setScalarEffect(PointEffect::Color2DChannels);
 
     // Render
@@ -872,21 +1006,17 @@ void ScatterplotPlugin::loadColors2D(const Dataset<Points>& pointsColor, const s
 
 void ScatterplotPlugin::loadColorsRGB(const Dataset<Points>& pointsColor, const std::uint32_t& dimensionIndexR, const std::uint32_t& dimensionIndexG, const std::uint32_t& dimensionIndexB)
 {
-    std::vector<float> colorScalarsR = {};
-    std::vector<float> colorScalarsG = {};
-    std::vector<float> colorScalarsB = {};
+    std::vector<std::vector<float>> colorScalars = {};
 
-    if (!mapColorScalars(pointsColor, dimensionIndexR, colorScalarsR) ||
-        !mapColorScalars(pointsColor, dimensionIndexG, colorScalarsG) ||
-        !mapColorScalars(pointsColor, dimensionIndexB, colorScalarsB)) {
+    if (!mapColorScalars(pointsColor, { dimensionIndexR, dimensionIndexG, dimensionIndexB }, colorScalars)) {
         _settingsAction->getColoringAction().getColorByAction().setCurrentIndex(0);  // reset to color by constant
         return;
     }
 
     // Assign the three channels and the RGB coloring effect
-    _scatterPlotWidget->setScalars(colorScalarsR);
-    _scatterPlotWidget->setScalars2(colorScalarsG);
-    _scatterPlotWidget->setScalars3(colorScalarsB);
+    _scatterPlotWidget->setScalars(colorScalars[0]);
+    _scatterPlotWidget->setScalars2(colorScalars[1]);
+    _scatterPlotWidget->setScalars3(colorScalars[2]);
     _scatterPlotWidget->setScalarEffect(PointEffect::ColorRGB);
 
     // Render
@@ -899,6 +1029,42 @@ void ScatterplotPlugin::loadColors(const Dataset<Clusters>& clusters)
     if (!clusters.isValid() || !_positionDataset.isValid())
         return;
 
+    updateClusterLabels(clusters);
+
+    // Cluster colors, indexed by cluster label
+    const auto& clusterVec = clusters->getClusters();
+
+    std::vector<Vector3f> palette(clusterVec.size());
+
+    for (std::size_t clusterIndex = 0; clusterIndex < clusterVec.size(); clusterIndex++) {
+        const auto color = clusterVec[clusterIndex].getColor();
+
+        palette[clusterIndex] = Vector3f(color.redF(), color.greenF(), color.blueF());
+    }
+
+    // Expand the labels into the color buffer for local colors (points without cluster are black), the renderer only takes per-point colors
+    std::vector<Vector3f> localColors(_numPoints);
+
+    std::visit([&palette, &localColors](const auto& labels) -> void {
+        forEachChunk(labels.size(), getNumberOfChunks(labels.size(), COLUMN_EXTRACTION_MINIMUM_CHUNK_SIZE), [&labels, &palette, &localColors](std::size_t chunkIndex, std::size_t begin, std::size_t end) -> void {
+            for (std::size_t localIndex = begin; localIndex < end; localIndex++) {
+                const auto label = labels[localIndex];
+
+                if (label < palette.size())
+                    localColors[localIndex] = palette[label];
+            }
+        });
+    }, _clusterLabels._labels);
+
+    // Apply colors to scatter plot widget without modification
+    _scatterPlotWidget->setColors(localColors);
+
+    // Render
+    getWidget().update();
+}
+
+void ScatterplotPlugin::updateClusterLabels(const Dataset<Clusters>& clusters)
+{
     // Get global indices from the position dataset
     std::uint64_t totalNumPoints = 0;
     if (_positionDataset->isDerivedData())
@@ -906,50 +1072,95 @@ void ScatterplotPlugin::loadColors(const Dataset<Clusters>& clusters)
     else
         totalNumPoints = _positionDataset->getFullDataset<Points>()->getNumPoints();
 
-    // Mapping from local to global indices
-    std::vector<std::uint32_t> globalIndices;
-    _positionDataset->getGlobalIndices(globalIndices);
+    const auto& clusterVec              = clusters->getClusters();
+    const auto  isOneClusterPerPoint    = totalNumPoints == _numPoints && clusterVec.size() == totalNumPoints;
 
-    // Generate color buffer for global and local colors
-    std::vector<Vector3f> globalColors(totalNumPoints);
-    std::vector<Vector3f> localColors(_numPoints);
+    // Up to 65535 clusters, 16-bit labels suffice (the maximum label marks points without cluster)
+    const auto hasCompactLabels = clusterVec.size() <= std::numeric_limits<std::uint16_t>::max();
+
+    auto& labeledClusters = _clusterLabels._labeledClusters;
+
+    // The labels can be extended when clusters were only appended (or recolored/renamed) since they were computed
+    auto canExtendLabels =
+        _clusterLabels._isValid &&
+        _clusterLabels._clusters.isValid() &&
+        _clusterLabels._clusters->getId() == clusters->getId() &&
+        _clusterLabels._positionDatasetId == _positionDataset->getId() &&
+        _clusterLabels._numberOfPositionPoints == _numPoints &&
+        _clusterLabels._isOneClusterPerPoint == isOneClusterPerPoint &&
+        std::holds_alternative<std::vector<std::uint16_t>>(_clusterLabels._labels) == hasCompactLabels &&
+        labeledClusters.size() <= static_cast<std::size_t>(clusterVec.size());
+
+    // Removed, replaced and resized clusters show in their identifiers and sizes, without walking their indices (see init for indices edited in place)
+    for (std::size_t clusterIndex = 0; canExtendLabels && clusterIndex < labeledClusters.size(); clusterIndex++)
+        canExtendLabels = labeledClusters[clusterIndex]._id == clusterVec[clusterIndex].getId() && labeledClusters[clusterIndex]._numberOfIndices == clusterVec[clusterIndex].getIndices().size();
+
+    if (!canExtendLabels) {
+        labeledClusters.clear();
+
+        if (hasCompactLabels)
+            _clusterLabels._labels = std::vector<std::uint16_t>(_numPoints, std::numeric_limits<std::uint16_t>::max());
+        else
+            _clusterLabels._labels = std::vector<std::uint32_t>(_numPoints, std::numeric_limits<std::uint32_t>::max());
+    }
+
+    const auto firstClusterIndex = labeledClusters.size();
+
+    // Only the appended clusters are labeled, names and colors are taken from the palette
+    if (firstClusterIndex < static_cast<std::size_t>(clusterVec.size())) {
+        std::visit([this, &clusters, isOneClusterPerPoint, firstClusterIndex](auto& labels) -> void {
+            labelClusterPoints(clusters, isOneClusterPerPoint, firstClusterIndex, labels);
+        }, _clusterLabels._labels);
+
+        for (std::size_t clusterIndex = firstClusterIndex; clusterIndex < static_cast<std::size_t>(clusterVec.size()); clusterIndex++) {
+            const auto& cluster = clusterVec[clusterIndex];
+
+            labeledClusters.push_back({ cluster.getId(), static_cast<std::size_t>(cluster.getIndices().size()), computeClusterSignature(cluster) });
+        }
+    }
+
+    if (!_clusterLabels._clusters.isValid() || _clusterLabels._clusters->getId() != clusters->getId())
+        _clusterLabels._clusters = clusters;
+
+    _clusterLabels._positionDatasetId       = _positionDataset->getId();
+    _clusterLabels._numberOfPositionPoints  = _numPoints;
+    _clusterLabels._isOneClusterPerPoint    = isOneClusterPerPoint;
+    _clusterLabels._isValid                 = true;
+}
+
+template<typename Label>
+void ScatterplotPlugin::labelClusterPoints(const Dataset<Clusters>& clusters, bool isOneClusterPerPoint, std::size_t firstClusterIndex, std::vector<Label>& labels)
+{
+    // Mapping from local to global indices (and back)
+    const auto& indexMapping = getIndexMapping();
 
     const auto& clusterVec = clusters->getClusters();
 
-    if (totalNumPoints == _numPoints && clusterVec.size() == totalNumPoints)
+    if (isOneClusterPerPoint)
     {
-        for (size_t i = 0; i < static_cast<size_t>(clusterVec.size()); i++)
+        for (size_t i = firstClusterIndex; i < static_cast<size_t>(clusterVec.size()); i++)
         {
             const auto& cluster = clusterVec[i];
-            const auto color    = cluster.getColor();
 
-            localColors[cluster.getIndices()[0]] = Vector3f(color.redF(), color.greenF(), color.blueF());
+            labels[cluster.getIndices()[0]] = static_cast<Label>(i);
         }
 
     }
-    else if(globalIndices.size() == _numPoints)
+    else if(indexMapping.getNumberOfPoints() == _numPoints)
     {
-        // Loop over all clusters and populate global colors
-        for (const auto& cluster : clusterVec)
+        // Loop over all clusters and label the (global) cluster indices which are part of the position dataset
+        for (size_t i = firstClusterIndex; i < static_cast<size_t>(clusterVec.size()); i++)
         {
-            const auto color  = cluster.getColor();
-            const auto colVec = Vector3f(color.redF(), color.greenF(), color.blueF());
-            for (const auto& index : cluster.getIndices())
-                globalColors[index] = colVec;
+            for (const auto& index : clusterVec[i].getIndices())
+            {
+                const auto localIndex = indexMapping.getLocalIndex(index);
 
-        }
+                if (localIndex != IndexMapping::INVALID_INDEX)
+                    labels[localIndex] = static_cast<Label>(i);
+            }
 
-        // Loop over all global indices and find the corresponding local color
-        std::int32_t localColorIndex = 0;
-        for (const auto& globalIndex : globalIndices)
-            localColors[localColorIndex++] = globalColors[globalIndex];
+        }
     }
-
-    // Apply colors to scatter plot widget without modification
-    _scatterPlotWidget->setColors(localColors);
-
-    // Render
-    getWidget().update();
 }
 
 ScatterplotWidget& ScatterplotPlugin::getScatterplotWidget()
@@ -974,29 +1185,69 @@ void ScatterplotPlugin::updateData()
         if (xDim < 0 || yDim < 0)
             return;
 
-        // Ensure that if positionDataset has now more points, the additional points are plotted
-        if (_numPoints != _positionDataset->getNumPoints())
-        {
-            _settingsAction->getPlotAction().getPointPlotAction().updateScatterPlotWidgetPointSizeScalars();
-            _settingsAction->getPlotAction().getPointPlotAction().updateScatterPlotWidgetPointOpacityScalars();
+        // Extract and index large datasets on the thread pool when the number of points does not change (e.g.
+        // when switching dimensions), the current positions keep being shown until the new ones are ready
+        if (_positionDataset->getNumPoints() >= ASYNCHRONOUS_UPDATE_MINIMUM_NUMBER_OF_POINTS && _positionDataset->getNumPoints() == _positions.size()) {
+            _positionsExtractor.start(_positionDataset, xDim, yDim);
+            return;
         }
 
-        // Determine number of points depending on if its a full dataset or a subset
-        _numPoints = _positionDataset->getNumPoints();
+        _positionsExtractor.cancel();
 
-        // Extract 2-dimensional points from the data set based on the selected dimensions
-        _positionDataset->extractDataForDimensions(_positions, xDim, yDim);
+        setPositions(PositionsExtractor::extract(*_positionDataset.get(), xDim, yDim));
+    }
+    else {
+        _positionsExtractor.cancel();
 
-        // Pass the 2D points to the scatter plot widget
+        _numPoints = 0;
+        _positions.clear();
+        _spatialIndex.clear();
+        _selectionState.clear();
         _scatterPlotWidget->setData(&_positions);
 
-        updateSelection();
+        emit selectionStateChanged();
+    }
+}
+
+void ScatterplotPlugin::setPositions(PositionsExtractor::Result result)
+{
+    // Ensure that if positionDataset has now more points, the additional points are plotted
+    if (_numPoints != _positionDataset->getNumPoints())
+    {
+        _settingsAction->getPlotAction().getPointPlotAction().updateScatterPlotWidgetPointSizeScalars();
+        _settingsAction->getPlotAction().getPointPlotAction().updateScatterPlotWidgetPointOpacityScalars();
+    }
+
+    // Determine number of points depending on if its a full dataset or a subset
+    _numPoints = _positionDataset->getNumPoints();
+
+    // Swap in the extracted positions (the widget keeps a pointer to them) and their index
+    _positions.swap(result._positions);
+
+    _spatialIndex = std::move(result._spatialIndex);
+
+    // Pass the 2D points to the scatter plot widget (the index already has the bounds of the finite positions)
+    if (_spatialIndex.isValid()) {
+        const auto& bounds = _spatialIndex.getBounds();
+
+        _scatterPlotWidget->setData(&_positions, Bounds(bounds._left, bounds._right, bounds._bottom, bounds._top));
     }
     else {
-        _numPoints = 0;
-        _positions.clear();
         _scatterPlotWidget->setData(&_positions);
     }
+
+    // The global indices (and thereby the color mapping and cluster labels) may have changed with the positions
+    _colorMapping._isValid = false;
+    _clusterLabels._isValid = false;
+
+    // A stroke in progress tested the previous positions, so its membership no longer holds
+    _incrementalSelection.end();
+
+    // Make sure the highlights are uploaded for the new positions
+    _selectionState.clear();
+    _focusHighlights.clear();
+
+    updateSelection();
 }
 
 void ScatterplotPlugin::updateSelection()
@@ -1008,35 +1259,24 @@ void ScatterplotPlugin::updateSelection()
 
     auto selection = _positionDataset->getSelection<Points>();
 
-    std::vector<bool> selected;
-    std::vector<char> highlights;
-
-    _positionDataset->selectedLocalIndices(selection->indices, selected);
+    const auto& indexMapping = getIndexMapping();
 
-    highlights.resize(_positionDataset->getNumPoints(), 0);
+    // Map the (global) selection indices to local indices once, all selection consumers read from the selection state
+    if (!_selectionState.update(indexMapping, selection->indices))
+        return;
 
-    for (std::size_t i = 0; i < selected.size(); i++)
-        highlights[i] = selected[i] ? 1 : 0;
+    _scatterPlotWidget->setHighlights(_selectionState.getMask(), static_cast<std::int32_t>(selection->indices.size()));
 
-    _scatterPlotWidget->setHighlights(highlights, static_cast<std::int32_t>(selection->indices.size()));
+    emit selectionStateChanged();
 
     if (getSamplerAction().getSamplingMode() == ViewPluginSamplerAction::SamplingMode::Selection) {
-        std::vector<std::uint32_t> localGlobalIndices;
-
-        _positionDataset->getGlobalIndices(localGlobalIndices);
-
-        std::vector<std::uint32_t> sampledPoints;
-
-        sampledPoints.reserve(_positions.size());
-
-        for (auto selectionIndex : selection->indices)
-            sampledPoints.push_back(selectionIndex);
+        const auto& sampledPoints = _selectionState.getLocalIndices();
 
         std::int32_t numberOfPoints = 0;
 
         QVariantList localPointIndices, globalPointIndices;
 
-        const auto numberOfSelectedPoints = selection->indices.size();
+        const auto numberOfSelectedPoints = sampledPoints.size();
 
         localPointIndices.reserve(static_cast<std::int32_t>(numberOfSelectedPoints));
         globalPointIndices.reserve(static_cast<std::int32_t>(numberOfSelectedPoints));
@@ -1046,7 +1286,7 @@ void ScatterplotPlugin::updateSelection()
                 break;
 
             const auto& localPointIndex = sampledPoint;
-            const auto& globalPointIndex = localGlobalIndices[localPointIndex];
+            const auto& globalPointIndex = indexMapping.getGlobalIndex(localPointIndex);
 
             localPointIndices << localPointIndex;
             globalPointIndices << globalPointIndex;
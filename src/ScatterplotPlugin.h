@@ -5,14 +5,26 @@
 #include <actions/HorizontalToolbarAction.h>
 #include <graphics/Vector2f.h>
 
+#include "ColumnStatisticsCache.h"
+#include "IncrementalSelection.h"
+#include "IndexMapping.h"
+#include "MappingCompatibilityCache.h"
+#include "PositionsExtractor.h"
+#include "SelectionPublisher.h"
+#include "SelectionState.h"
 #include "SettingsAction.h"
+#include "SpatialIndex.h"
 
 #include <QTimer>
 
+#include <limits>
+#include <variant>
+
 using namespace mv::plugin;
 using namespace mv::util;
 using namespace mv::gui;
 
+class Clusters;
 class Points;
 class ScatterplotWidget;
 
@@ -94,12 +106,29 @@ public: // Miscellaneous
     /** Get smart pointer to source of the points dataset for point position (if any) */
     Dataset<Points>& getPositionSourceDataset();
 
+    /**
+     * Get the local/global index mapping of the position dataset (filled on first use after the position dataset or its data changed)
+     * @return Reference to the index mapping
+     */
+    const IndexMapping& getIndexMapping();
+
+    /** Get the selection of the position dataset in local point indices (updated on each selection change) */
+    const SelectionState& getSelectionState() const { return _selectionState; }
+
     /** Use the pixel selection tool to select data points */
     void selectPoints();
 
     /** Use the sampler pixel selection tool to sample data points */
     void samplePoints();
 
+private:
+
+    /**
+     * Focus highlight \p focusedLocalIndices, only the focus highlights of the previously and newly focused points are updated
+     * @param focusedLocalIndices Local indices of the points to focus highlight
+     */
+    void updateFocusHighlights(std::vector<std::uint32_t> focusedLocalIndices);
+
 public:
 
     /** Get reference to the scatter plot widget */
@@ -107,8 +136,21 @@ public:
 
     SettingsAction& getSettingsAction() { return *_settingsAction; }
 
+    /** Get reference to the selection publisher */
+    SelectionPublisher& getSelectionPublisher() { return _selectionPublisher; }
+
+    /** Get reference to the dimension statistics cache (shared by the settings actions) */
+    ColumnStatisticsCache& getColumnStatisticsCache() { return _columnStatisticsCache; }
+
 private:
     void updateData();
+
+    /**
+     * Show \p result (extracted from the position dataset)
+     * @param result Extracted positions and their spatial index
+     */
+    void setPositions(PositionsExtractor::Result result);
+
     void updateSelection();
     void updateHeadsUpDisplayTextColor();
 
@@ -116,6 +158,11 @@ public:
 
     void updateHeadsUpDisplay();
 
+signals:
+
+    /** Signals that the selection state was updated (after the selection or the position data changed) */
+    void selectionStateChanged();
+
 public: // Serialization
 
     /**
@@ -141,19 +188,104 @@ private:
      */
     bool mapColorScalars(const Dataset<Points>& pointsColor, const std::uint32_t& dimensionIndex, std::vector<float>& colorScalars);
 
+    /**
+     * Extract dimensions \p dimensionIndices from \p pointsColor and map them into the position dataset's point space, resolving the mapping
+     * and reading the color data only once for all dimensions
+     * @param pointsColor Smart pointer to the color points dataset
+     * @param dimensionIndices Indices of the dimensions to extract
+     * @param colorScalars Output vectors of scalars (one per dimension), sized to the number of position points on success
+     * @return Boolean determining whether the mapping succeeded
+     */
+    bool mapColorScalars(const Dataset<Points>& pointsColor, const std::vector<std::uint32_t>& dimensionIndices, std::vector<std::vector<float>>& colorScalars);
+
+    /**
+     * Get the color mapping of \p pointsColor, computed once per pair of color and position dataset (until either changes)
+     * @param pointsColor Smart pointer to the color points dataset
+     * @return Pointer to the color point index per position point (empty when the point counts match), nullptr when the color dataset does not match the position dataset in a known way
+     */
+    const std::vector<std::uint32_t>* getColorMapping(const Dataset<Points>& pointsColor);
+
+    /**
+     * Resolve for each position point the index of the \p pointsColor point it takes its color from
+     * (prefer global IDs (for derived data) over selection mapping, prefer color to position over position to color over source of position to color)
+     * @param pointsColor Smart pointer to the color points dataset
+     * @param colorIndices Output color point index per position point (UNMAPPED_COLOR_INDEX for unmapped points), empty when the point counts match
+     * @return Boolean determining whether the color dataset matches the position dataset in a known way
+     */
+    bool computeColorMapping(const Dataset<Points>& pointsColor, std::vector<std::uint32_t>& colorIndices);
+
+    /**
+     * Bring the cached cluster labels up to date with \p clusters, only labeling the appended clusters when the existing clusters are unchanged
+     * @param clusters Smart pointer to the clusters dataset
+     */
+    void updateClusterLabels(const Dataset<Clusters>& clusters);
+
+    /**
+     * Label the position points of the clusters of \p clusters from \p firstClusterIndex onwards with their cluster index (later clusters take precedence)
+     * @param clusters Smart pointer to the clusters dataset
+     * @param isOneClusterPerPoint Whether each cluster holds a single point of the (full) position dataset
+     * @param firstClusterIndex Index of the first cluster to label
+     * @param labels Cluster label per position point (the maximum of \p Label for points which are not in any cluster)
+     */
+    template<typename Label>
+    void labelClusterPoints(const Dataset<Clusters>& clusters, bool isOneClusterPerPoint, std::size_t firstClusterIndex, std::vector<Label>& labels);
+
+    /** Identity of a labeled cluster, to tell which clusters changed since the cluster labels were computed */
+    struct LabeledCluster {
+        QString                     _id;                            /** Globally unique identifier of the cluster */
+        std::size_t                 _numberOfIndices = 0;           /** Number of point indices of the cluster */
+        std::uint64_t               _signature = 0;                 /** Signature of the point indices of the cluster (detects indices edited in place) */
+    };
+
+    /** Cached cluster labels of a clusters dataset, so that cluster color changes only re-expand the cluster palette */
+    struct ClusterLabels {
+        Dataset<Clusters>           _clusters;                      /** Smart pointer to the clusters dataset (watched for data changes) */
+        QString                     _positionDatasetId;             /** Globally unique identifier of the position dataset */
+        std::uint64_t               _numberOfPositionPoints = 0;    /** Number of position points at the time the labels were computed */
+        bool                        _isOneClusterPerPoint = false;  /** Whether the labels were computed with one cluster per point */
+        std::vector<LabeledCluster> _labeledClusters;               /** Labeled clusters, in cluster order */
+        std::variant<std::vector<std::uint16_t>, std::vector<std::uint32_t>> _labels;  /** Cluster label per position point, 16-bit for up to 65535 clusters (see labelClusterPoints) */
+        bool                        _isValid = false;               /** Whether the labels are up to date */
+    };
+
+    /** Cached color mapping of a color dataset */
+    struct ColorMapping {
+        QString                     _colorDatasetId;                /** Globally unique identifier of the color dataset */
+        QString                     _positionDatasetId;             /** Globally unique identifier of the position dataset */
+        std::uint64_t               _numberOfColorPoints = 0;       /** Number of color points at the time the mapping was computed (identity mappings have no compatibility cache entry) */
+        std::uint64_t               _numberOfPositionPoints = 0;    /** Number of position points at the time the mapping was computed */
+        std::vector<std::uint32_t>  _colorIndices;                  /** Color point index per position point (see computeColorMapping) */
+        bool                        _isValid = false;               /** Whether the mapping is up to date */
+    };
+
 private:
     mv::gui::DropWidget*                _dropWidget;                /** Widget for dropping datasets */
     ScatterplotWidget*                  _scatterPlotWidget;         /** The visualization widget */
     Dataset<Points>                     _positionDataset;           /** Smart pointer to points dataset for point position */
     Dataset<Points>                     _positionSourceDataset;     /** Smart pointer to source of the points dataset for point position (if any) */
     std::vector<mv::Vector2f>           _positions;                 /** Point positions */
+    SpatialIndex                        _spatialIndex;              /** Uniform grid over the point positions (used to limit selection to the selection area) */
+    IndexMapping                        _indexMapping;              /** Cached local/global index mapping of the position dataset */
+    SelectionState                      _selectionState;            /** Selection of the position dataset in local point indices */
+    std::vector<char>                   _focusHighlights;           /** Per-point sampler focus highlights (kept between samples) */
+    std::vector<std::uint32_t>          _focusedLocalIndices;       /** Sorted local indices of the focus highlighted points */
+    IncrementalSelection                _incrementalSelection;      /** State of the brush/lasso stroke in progress (in incremental selection mode) */
     std::uint64_t                       _numPoints;                 /** Number of point positions */
+
+    // The settings actions hook up to these helpers on construction, so they are constructed first
+    SelectionPublisher                  _selectionPublisher;        /** Publishes selections (rate-limited during selection strokes) */
+    PositionsExtractor                  _positionsExtractor;        /** Extracts the positions of large datasets on the thread pool */
+    ColumnStatisticsCache               _columnStatisticsCache;     /** Cached statistics of dataset dimensions */
+    MappingCompatibilityCache           _mappingCompatibilityCache; /** Cached compatibility of color datasets with position datasets */
+
     QPointer<SettingsAction>            _settingsAction;            /** Group action for all settings */
     QPointer<HorizontalToolbarAction>   _primaryToolbarAction;      /** Horizontal toolbar for primary content */
     QRectF                              _selectionBoundaries;       /** Boundaries of the selection */
+    ColorMapping                        _colorMapping;              /** Cached mapping from the last color dataset to the position dataset */
+    ClusterLabels                       _clusterLabels;             /** Cached cluster labels of the last clusters dataset */
 
-    static const std::int32_t LAZY_UPDATE_INTERVAL = 2;
-
+    static constexpr std::uint32_t ASYNCHRONOUS_UPDATE_MINIMUM_NUMBER_OF_POINTS = 1'000'000;   /** Positions of datasets with at least this many points are extracted on the thread pool (when the number of points does not change) */
+    static constexpr std::uint32_t UNMAPPED_COLOR_INDEX = std::numeric_limits<std::uint32_t>::max();  /** Color index of position points which are not mapped to a color point */
 };
 
 // =============================================================================
@@ -1,4 +1,5 @@
 #include "ScatterplotWidget.h"
+#include "ColumnStatistics.h"
 
 #include <CoreInterface.h>
 
@@ -22,17 +23,20 @@ namespace
 {
     Bounds getDataBounds(const std::vector<Vector2f>& points)
     {
-        Bounds bounds = Bounds::Max;
+        if (points.empty())
+            return Bounds::Max;
 
-        for (const Vector2f& point : points)
-        {
-            bounds.setLeft(std::min(point.x, bounds.getLeft()));
-            bounds.setRight(std::max(point.x, bounds.getRight()));
-            bounds.setBottom(std::min(point.y, bounds.getBottom()));
-            bounds.setTop(std::max(point.y, bounds.getTop()));
-        }
+        const auto statisticsX = computeColumnStatistics(&points.front().x, points.size(), 2);
+        const auto statisticsY = computeColumnStatistics(&points.front().y, points.size(), 2);
+
+        // Non-finite coordinates are excluded from the bounds
+        if (statisticsX.getNumberOfNonFiniteValues() > 0 || statisticsY.getNumberOfNonFiniteValues() > 0)
+            qDebug() << "ScatterplotWidget: excluded" << statisticsX.getNumberOfNonFiniteValues() << "non-finite x-coordinates and" << statisticsY.getNumberOfNonFiniteValues() << "non-finite y-coordinates from the data bounds";
 
-        return bounds;
+        if (!statisticsX.hasFiniteValues() || !statisticsY.hasFiniteValues())
+            return Bounds::Max;
+
+        return Bounds(statisticsX._minimum, statisticsX._maximum, statisticsY._minimum, statisticsY._maximum);
     }
 }
 
@@ -266,8 +270,11 @@ void ScatterplotWidget::computeDensity()
 // by reference then we can upload the data to the GPU, but not store it in the widget.
 void ScatterplotWidget::setData(const std::vector<Vector2f>* points)
 {
-    auto dataBounds = getDataBounds(*points);
+    setData(points, getDataBounds(*points));
+}
 
+void ScatterplotWidget::setData(const std::vector<Vector2f>* points, const Bounds& dataBounds)
+{
     const auto dataBoundsRect = QRectF(QPointF(dataBounds.getLeft(), dataBounds.getBottom()), QSizeF(dataBounds.getWidth(), dataBounds.getHeight()));
 
     _pointRenderer.setDataBounds(dataBoundsRect);
@@ -355,12 +362,20 @@ void ScatterplotWidget::setColors(const std::vector<Vector3f>& colors)
 }
 
 void ScatterplotWidget::setPointSizeScalars(const std::vector<float>& pointSizeScalars)
+{
+    if (pointSizeScalars.empty())
+        return;
+
+    setPointSizeScalars(pointSizeScalars, *std::max_element(pointSizeScalars.begin(), pointSizeScalars.end()));
+}
+
+void ScatterplotWidget::setPointSizeScalars(const std::vector<float>& pointSizeScalars, float maximumPointSize)
 {
     if (pointSizeScalars.empty())
         return;
 
     _pointRenderer.setSizeChannelScalars(pointSizeScalars);
-    _pointRenderer.setPointSize(*std::max_element(pointSizeScalars.begin(), pointSizeScalars.end()));
+    _pointRenderer.setPointSize(maximumPointSize);
 
     update();
 }
@@ -77,6 +77,13 @@ public:
      * Feed 2-dimensional data to the scatterplot.
      */
     void setData(const std::vector<mv::Vector2f>* data);
+
+    /**
+     * Feed 2-dimensional data with precomputed bounds to the scatterplot
+     * @param data Pointer to the point positions (needs to outlive the widget data)
+     * @param dataBounds Bounds of \p data
+     */
+    void setData(const std::vector<mv::Vector2f>* data, const mv::Bounds& dataBounds);
     void setHighlights(const std::vector<char>& highlights, const std::int32_t& numSelectedPoints);
     void setScalars(const std::vector<float>& scalars);
 
@@ -98,6 +105,13 @@ public:
      */
     void setPointSizeScalars(const std::vector<float>& pointSizeScalars);
 
+    /**
+     * Set point size scalars with their precomputed maximum
+     * @param pointSizeScalars Point size scalars
+     * @param maximumPointSize Maximum of \p pointSizeScalars
+     */
+    void setPointSizeScalars(const std::vector<float>& pointSizeScalars, float maximumPointSize);
+
     /**
      * Set point opacity scalars
      * @param pointOpacityScalars Point opacity scalars (assume the values are normalized)
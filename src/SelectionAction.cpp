@@ -15,7 +15,10 @@ SelectionAction::SelectionAction(QObject* parent, const QString& title) :
     _outlineScaleAction(this, "Scale", 100.0f, 500.0f, 200.0f, 1),
     _outlineOpacityAction(this, "Opacity", 0.0f, 100.0f, 100.0f, 1),
     _outlineHaloEnabledAction(this, "Halo"),
-    _freezeSelectionAction(this, "Freeze selection")
+    _freezeSelectionAction(this, "Freeze selection"),
+    _incrementalAction(this, "Incremental", true),
+    _maximumRateAction(this, "Max. rate", 0, 120, 30),
+    _publishStatusAction(this, "Publish status")
 {
     setIconByName("mouse-pointer");
     
@@ -36,13 +39,21 @@ SelectionAction::SelectionAction(QObject* parent, const QString& title) :
     addAction(&getOutlineOpacityAction());
     addAction(&getOutlineHaloEnabledAction());
     addAction(&getFreezeSelectionAction());
+    addAction(&getIncrementalAction());
+    addAction(&getMaximumRateAction());
+    addAction(&getPublishStatusAction());
 
     _pixelSelectionAction.getOverlayColorAction().setText("Color");
 
     _displayModeAction.setToolTip("The way in which selection is visualized");
+    _incrementalAction.setToolTip("When notifying during selection, brush and lasso strokes only process the points under the part of the selection area which changed since the previous update");
+
+    _maximumRateAction.setToolTip("Maximum number of times per second the selection is published to linked views while selecting (zero publishes every update)");
+    _publishStatusAction.setToolTip("Number of selection updates during the last stroke which were coalesced before being published");
 
     _outlineScaleAction.setSuffix("%");
     _outlineOpacityAction.setSuffix("%");
+    _maximumRateAction.setSuffix(" Hz");
 
     const auto updateActionsReadOnly = [this]() -> void {
         const auto isOutline = static_cast<PointSelectionDisplayMode>(_displayModeAction.getCurrentIndex()) == PointSelectionDisplayMode::Outline;
@@ -127,6 +138,19 @@ void SelectionAction::initialize(ScatterplotPlugin* scatterplotPlugin)
         scatterplotPlugin->getScatterplotWidget().setSelectionOutlineOverrideColor(toggled);
     });
 
+    auto& selectionPublisher = scatterplotPlugin->getSelectionPublisher();
+
+    selectionPublisher.setMaximumRate(_maximumRateAction.getValue());
+
+    connect(&_maximumRateAction, &IntegralAction::valueChanged, this, [&selectionPublisher](std::int32_t value) {
+        selectionPublisher.setMaximumRate(value);
+    });
+
+    connect(&selectionPublisher, &SelectionPublisher::strokeEnded, this, [this](std::uint32_t numberOfSelections, std::uint32_t numberOfCoalescedSelections) {
+        _publishStatusAction.setStatus(StatusAction::Info);
+        _publishStatusAction.setMessage(QString("%1 of %2 updates coalesced").arg(QString::number(numberOfCoalescedSelections), QString::number(numberOfSelections)));
+    });
+
     const auto updateReadOnly = [this, scatterplotPlugin]() -> void {
         setEnabled(scatterplotPlugin->getPositionDataset().isValid());
     };
@@ -153,6 +177,8 @@ void SelectionAction::connectToPublicAction(WidgetAction* publicAction, bool rec
         actions().connectPrivateActionToPublicAction(&_outlineOpacityAction, &publicSelectionAction->getOutlineOpacityAction(), recursive);
         actions().connectPrivateActionToPublicAction(&_outlineHaloEnabledAction, &publicSelectionAction->getOutlineHaloEnabledAction(), recursive);
         actions().connectPrivateActionToPublicAction(&_freezeSelectionAction, &publicSelectionAction->getFreezeSelectionAction(), recursive);
+        actions().connectPrivateActionToPublicAction(&_incrementalAction, &publicSelectionAction->getIncrementalAction(), recursive);
+        actions().connectPrivateActionToPublicAction(&_maximumRateAction, &publicSelectionAction->getMaximumRateAction(), recursive);
     }
 
     GroupAction::connectToPublicAction(publicAction, recursive);
@@ -171,6 +197,8 @@ void SelectionAction::disconnectFromPublicAction(bool recursive)
         actions().disconnectPrivateActionFromPublicAction(&_outlineOpacityAction, recursive);
         actions().disconnectPrivateActionFromPublicAction(&_outlineHaloEnabledAction, recursive);
         actions().disconnectPrivateActionFromPublicAction(&_freezeSelectionAction, recursive);
+        actions().disconnectPrivateActionFromPublicAction(&_incrementalAction, recursive);
+        actions().disconnectPrivateActionFromPublicAction(&_maximumRateAction, recursive);
     }
 
     GroupAction::disconnectFromPublicAction(recursive);
@@ -188,6 +216,8 @@ void SelectionAction::fromVariantMap(const QVariantMap& variantMap)
     _outlineOpacityAction.fromParentVariantMap(variantMap);
     _outlineHaloEnabledAction.fromParentVariantMap(variantMap);
     _freezeSelectionAction.fromParentVariantMap(variantMap);
+    _incrementalAction.fromParentVariantMap(variantMap);
+    _maximumRateAction.fromParentVariantMap(variantMap);
 }
 
 QVariantMap SelectionAction::toVariantMap() const
@@ -202,6 +232,8 @@ QVariantMap SelectionAction::toVariantMap() const
     _outlineOpacityAction.insertIntoVariantMap(variantMap);
     _outlineHaloEnabledAction.insertIntoVariantMap(variantMap);
     _freezeSelectionAction.insertIntoVariantMap(variantMap);
+    _incrementalAction.insertIntoVariantMap(variantMap);
+    _maximumRateAction.insertIntoVariantMap(variantMap);
 
     return variantMap;
 }
\ No newline at end of file
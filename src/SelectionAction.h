@@ -1,7 +1,9 @@
 #pragma once
 
 #include <actions/GroupAction.h>
+#include <actions/IntegralAction.h>
 #include <actions/PixelSelectionAction.h>
+#include <actions/StatusAction.h>
 
 class ScatterplotPlugin;
 
@@ -65,6 +67,9 @@ public: // Action getters
     DecimalAction& getOutlineOpacityAction() { return _outlineOpacityAction; }
     ToggleAction& getOutlineHaloEnabledAction() { return _outlineHaloEnabledAction; }
     ToggleAction& getFreezeSelectionAction() { return _freezeSelectionAction; }
+    ToggleAction& getIncrementalAction() { return _incrementalAction; }
+    IntegralAction& getMaximumRateAction() { return _maximumRateAction; }
+    StatusAction& getPublishStatusAction() { return _publishStatusAction; }
 
 private:
     PixelSelectionAction    _pixelSelectionAction;          /** Pixel selection action */
@@ -75,6 +80,9 @@ private:
     DecimalAction           _outlineOpacityAction;          /** Selection outline opacity action */
     ToggleAction            _outlineHaloEnabledAction;      /** Selection outline halo enabled action */
     ToggleAction            _freezeSelectionAction;         /** Freeze selection action */
+    ToggleAction            _incrementalAction;             /** Only process the changed part of brush/lasso strokes action */
+    IntegralAction          _maximumRateAction;             /** Maximum selection publication rate during strokes action (in Hz) */
+    StatusAction            _publishStatusAction;           /** Selection publication statistics of the last stroke action */
 
     friend class mv::AbstractActionsManager;
 };
@@ -0,0 +1,320 @@
+#include "SelectionKernel.h"
+
+#include "ParallelUtils.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+    /** Grow \p bounds such that it encloses \p position */
+    void growBounds(SpatialIndex::Rectangle& bounds, const mv::Vector2f& position)
+    {
+        bounds._left    = std::min(bounds._left, position.x);
+        bounds._right   = std::max(bounds._right, position.x);
+        bounds._bottom  = std::min(bounds._bottom, position.y);
+        bounds._top     = std::max(bounds._top, position.y);
+    }
+
+    /** Grow \p bounds such that it encloses \p other */
+    void growBounds(SpatialIndex::Rectangle& bounds, const SpatialIndex::Rectangle& other)
+    {
+        bounds._left    = std::min(bounds._left, other._left);
+        bounds._right   = std::max(bounds._right, other._right);
+        bounds._bottom  = std::min(bounds._bottom, other._bottom);
+        bounds._top     = std::max(bounds._top, other._top);
+    }
+
+    /**
+     * Process \p localIndices in parallel with \p processChunk and append the per-chunk results (in order) to \p result
+     * @param localIndices Local point indices
+     * @param minimumChunkSize Minimum number of points per chunk
+     * @param processChunk Function which processes a span of local indices into a chunk result
+     * @param result Result to append to
+     */
+    template<typename ProcessChunk>
+    void processChunks(std::span<const std::uint32_t> localIndices, std::size_t minimumChunkSize, ProcessChunk processChunk, SelectionKernel::Result& result)
+    {
+        const auto numberOfChunks = getNumberOfChunks(localIndices.size(), minimumChunkSize);
+
+        std::vector<SelectionKernel::Result> chunkResults(numberOfChunks);
+
+        forEachChunk(localIndices.size(), numberOfChunks, [&localIndices, &processChunk, &chunkResults](std::size_t chunkIndex, std::size_t begin, std::size_t end) -> void {
+            processChunk(localIndices.subspan(begin, end - begin), chunkResults[chunkIndex]);
+        });
+
+        std::size_t numberOfSelectedPoints = result._localIndices.size();
+
+        for (const auto& chunkResult : chunkResults)
+            numberOfSelectedPoints += chunkResult._localIndices.size();
+
+        result._localIndices.reserve(numberOfSelectedPoints);
+
+        for (const auto& chunkResult : chunkResults) {
+            result._localIndices.insert(result._localIndices.end(), chunkResult._localIndices.begin(), chunkResult._localIndices.end());
+
+            growBounds(result._bounds, chunkResult._bounds);
+        }
+    }
+}
+
+SelectionMask::SelectionMask(const QImage& areaImage, const QRect& screenRectangle)
+{
+    const auto alphaImage       = areaImage.convertToFormat(QImage::Format_Alpha8);
+    const auto clippedRectangle = screenRectangle.intersected(alphaImage.rect());
+
+    if (clippedRectangle.isEmpty())
+        return;
+
+    const auto width = static_cast<std::size_t>(clippedRectangle.width());
+
+    std::vector<std::uint8_t> pixels(width * static_cast<std::size_t>(clippedRectangle.height()));
+
+    for (int y = clippedRectangle.top(); y <= clippedRectangle.bottom(); y++) {
+        const auto scanLine = alphaImage.constScanLine(y) + clippedRectangle.left();
+        const auto row      = pixels.data() + static_cast<std::size_t>(y - clippedRectangle.top()) * width;
+
+        for (std::size_t x = 0; x < width; x++)
+            row[x] = scanLine[x] > 0 ? 1 : 0;
+    }
+
+    initialize(clippedRectangle, pixels);
+}
+
+SelectionMask SelectionMask::getDifference(const SelectionMask& selectionMaskA, const SelectionMask& selectionMaskB)
+{
+    SelectionMask difference;
+
+    const auto rectangle = selectionMaskA._boundingRectangle.united(selectionMaskB._boundingRectangle);
+
+    if (rectangle.isEmpty())
+        return difference;
+
+    const auto width = static_cast<std::size_t>(rectangle.width());
+
+    std::vector<std::uint8_t> pixels(width * static_cast<std::size_t>(rectangle.height()));
+
+    for (int y = rectangle.top(); y <= rectangle.bottom(); y++) {
+        const auto row = pixels.data() + static_cast<std::size_t>(y - rectangle.top()) * width;
+
+        for (int x = rectangle.left(); x <= rectangle.right(); x++)
+            row[x - rectangle.left()] = selectionMaskA.contains(x, y) != selectionMaskB.contains(x, y) ? 1 : 0;
+    }
+
+    difference.initialize(rectangle, pixels);
+
+    return difference;
+}
+
+void SelectionMask::initialize(const QRect& rectangle, const std::vector<std::uint8_t>& pixels)
+{
+    const auto rectangleWidth = static_cast<std::size_t>(rectangle.width());
+
+    auto left   = std::numeric_limits<int>::max();
+    auto right  = std::numeric_limits<int>::lowest();
+    auto top    = std::numeric_limits<int>::max();
+    auto bottom = std::numeric_limits<int>::lowest();
+
+    for (int y = rectangle.top(); y <= rectangle.bottom(); y++) {
+        const auto row = pixels.data() + static_cast<std::size_t>(y - rectangle.top()) * rectangleWidth;
+
+        for (int x = rectangle.left(); x <= rectangle.right(); x++) {
+            if (row[x - rectangle.left()] == 0)
+                continue;
+
+            left    = std::min(left, x);
+            right   = std::max(right, x);
+            top     = std::min(top, y);
+            bottom  = std::max(bottom, y);
+        }
+    }
+
+    if (left > right)
+        return;
+
+    _boundingRectangle = QRect(QPoint(left, top), QPoint(right, bottom));
+
+    const auto width    = static_cast<std::size_t>(_boundingRectangle.width());
+    const auto height   = static_cast<std::size_t>(_boundingRectangle.height());
+
+    _pixels.resize(width * height);
+    _summedArea.assign((width + 1) * (height + 1), 0);
+
+    for (std::size_t y = 0; y < height; y++) {
+        const auto row = pixels.data() + static_cast<std::size_t>(top - rectangle.top() + static_cast<int>(y)) * rectangleWidth + (left - rectangle.left());
+
+        std::uint32_t rowSum = 0;
+
+        for (std::size_t x = 0; x < width; x++) {
+            _pixels[y * width + x] = row[x];
+
+            rowSum += row[x];
+
+            _summedArea[(y + 1) * (width + 1) + x + 1] = _summedArea[y * (width + 1) + x + 1] + rowSum;
+        }
+    }
+}
+
+std::uint32_t SelectionMask::count(const QRect& rectangle) const
+{
+    const auto clippedRectangle = rectangle.intersected(_boundingRectangle);
+
+    if (clippedRectangle.isEmpty())
+        return 0;
+
+    const auto width    = static_cast<std::size_t>(_boundingRectangle.width()) + 1;
+    const auto left     = static_cast<std::size_t>(clippedRectangle.left() - _boundingRectangle.left());
+    const auto right    = static_cast<std::size_t>(clippedRectangle.right() - _boundingRectangle.left()) + 1;
+    const auto top      = static_cast<std::size_t>(clippedRectangle.top() - _boundingRectangle.top());
+    const auto bottom   = static_cast<std::size_t>(clippedRectangle.bottom() - _boundingRectangle.top()) + 1;
+
+    return _summedArea[bottom * width + right] - _summedArea[top * width + right] - _summedArea[bottom * width + left] + _summedArea[top * width + left];
+}
+
+ScreenProjection::ScreenProjection(const QRectF& zoomRectangleWorld, const QSize& screenSize) :
+    _worldLeft(static_cast<float>(zoomRectangleWorld.left())),
+    _worldTop(static_cast<float>(zoomRectangleWorld.top())),
+    _scaleX(static_cast<float>(screenSize.width() / zoomRectangleWorld.width())),
+    _scaleY(static_cast<float>(screenSize.height() / zoomRectangleWorld.height())),
+    _screenWidth(static_cast<float>(screenSize.width())),
+    _screenHeight(static_cast<float>(screenSize.height()))
+{
+}
+
+SpatialIndex::Rectangle ScreenProjection::getWorldRectangle(const QRect& screenRectangle) const
+{
+    return {
+        _worldLeft + static_cast<float>(screenRectangle.left() - 1) / _scaleX,
+        _worldLeft + static_cast<float>(screenRectangle.right() + 2) / _scaleX,
+        _worldTop + (_screenHeight - static_cast<float>(screenRectangle.bottom() + 2)) / _scaleY,
+        _worldTop + (_screenHeight - static_cast<float>(screenRectangle.top() - 1)) / _scaleY
+    };
+}
+
+QRect ScreenProjection::getScreenRectangle(const SpatialIndex::Rectangle& worldRectangle) const
+{
+    const auto left     = static_cast<int>(getScreenX(worldRectangle._left)) - 1;
+    const auto right    = static_cast<int>(getScreenX(worldRectangle._right)) + 1;
+    const auto top      = static_cast<int>(getScreenY(worldRectangle._top)) - 1;
+    const auto bottom   = static_cast<int>(getScreenY(worldRectangle._bottom)) + 1;
+
+    return QRect(QPoint(left, top), QPoint(right, bottom));
+}
+
+QRect ScreenProjection::getScreenRectangle() const
+{
+    return QRect(0, 0, static_cast<int>(_screenWidth), static_cast<int>(_screenHeight));
+}
+
+SelectionKernel::SelectionKernel(const std::vector<mv::Vector2f>& positions, const SelectionMask& selectionMask, const ScreenProjection& screenProjection) :
+    _positions(positions),
+    _selectionMask(selectionMask),
+    _screenProjection(screenProjection)
+{
+}
+
+SelectionKernel::Result SelectionKernel::select(const SpatialIndex& spatialIndex) const
+{
+    Result result;
+
+    if (_selectionMask.isEmpty() || !spatialIndex.isValid())
+        return result;
+
+    SpatialIndex::CellRange cellRange;
+
+    if (!spatialIndex.getCellRange(_screenProjection.getWorldRectangle(_selectionMask.getBoundingRectangle()), cellRange))
+        return result;
+
+    const auto screenRectangle = _screenProjection.getScreenRectangle();
+
+    std::vector<std::uint32_t> acceptedLocalIndices, candidateLocalIndices;
+
+    // Only visit the cells which overlap the selection area, and accept or reject cells in bulk when
+    // their screen footprint lies wholly inside or outside the selection area
+    for (std::uint32_t row = cellRange._rowBegin; row <= cellRange._rowEnd; row++) {
+        for (std::uint32_t column = cellRange._columnBegin; column <= cellRange._columnEnd; column++) {
+            const auto cellPointIndices = spatialIndex.getCellPointIndices(column, row);
+
+            if (cellPointIndices.empty())
+                continue;
+
+            const auto cellRectangleScreen      = _screenProjection.getScreenRectangle(spatialIndex.getCellRectangle(column, row));
+            const auto numberOfSelectedPixels   = _selectionMask.count(cellRectangleScreen);
+
+            if (numberOfSelectedPixels == 0)
+                continue;
+
+            const auto cellArea = static_cast<std::uint64_t>(cellRectangleScreen.width()) * static_cast<std::uint64_t>(cellRectangleScreen.height());
+
+            auto& localIndices = screenRectangle.contains(cellRectangleScreen) && numberOfSelectedPixels == cellArea ? acceptedLocalIndices : candidateLocalIndices;
+
+            localIndices.insert(localIndices.end(), cellPointIndices.begin(), cellPointIndices.end());
+        }
+    }
+
+    acceptPoints(acceptedLocalIndices, result);
+    testPoints(candidateLocalIndices, result);
+
+    // Cells are visited in spatial order, restore the local point order (large selections are
+    // flagged and compacted, which is linear in the number of points instead of sorting)
+    if (result._localIndices.size() * DENSE_SELECTION_RATIO > _positions.size()) {
+        std::vector<std::uint8_t> isSelected(_positions.size(), 0);
+
+        for (const auto localIndex : result._localIndices)
+            isSelected[localIndex] = 1;
+
+        result._localIndices.clear();
+
+        for (std::uint32_t localIndex = 0; localIndex < isSelected.size(); localIndex++)
+            if (isSelected[localIndex])
+                result._localIndices.push_back(localIndex);
+    }
+    else {
+        std::sort(result._localIndices.begin(), result._localIndices.end());
+    }
+
+    return result;
+}
+
+void SelectionKernel::testPoints(std::span<const std::uint32_t> localIndices, Result& result) const
+{
+    processChunks(localIndices, MINIMUM_CHUNK_SIZE, [this](std::span<const std::uint32_t> chunkLocalIndices, Result& chunkResult) -> void {
+        float screenX[BATCH_SIZE];
+        float screenY[BATCH_SIZE];
+
+        for (std::size_t batchBegin = 0; batchBegin < chunkLocalIndices.size(); batchBegin += BATCH_SIZE) {
+            const auto batchSize    = std::min(BATCH_SIZE, chunkLocalIndices.size() - batchBegin);
+            const auto batchIndices = chunkLocalIndices.data() + batchBegin;
+
+            // Project the batch to screen space (branch-free, so that it vectorizes)
+            for (std::size_t batchIndex = 0; batchIndex < batchSize; batchIndex++) {
+                const auto& position = _positions[batchIndices[batchIndex]];
+
+                screenX[batchIndex] = _screenProjection.getScreenX(position.x);
+                screenY[batchIndex] = _screenProjection.getScreenY(position.y);
+            }
+
+            // Look up the projected points in the selection mask (which lies within the screen)
+            for (std::size_t batchIndex = 0; batchIndex < batchSize; batchIndex++) {
+                if (!_selectionMask.contains(static_cast<int>(screenX[batchIndex]), static_cast<int>(screenY[batchIndex])))
+                    continue;
+
+                const auto localIndex = batchIndices[batchIndex];
+
+                chunkResult._localIndices.push_back(localIndex);
+
+                growBounds(chunkResult._bounds, _positions[localIndex]);
+            }
+        }
+    }, result);
+}
+
+void SelectionKernel::acceptPoints(std::span<const std::uint32_t> localIndices, Result& result) const
+{
+    processChunks(localIndices, MINIMUM_CHUNK_SIZE, [this](std::span<const std::uint32_t> chunkLocalIndices, Result& chunkResult) -> void {
+        chunkResult._localIndices.assign(chunkLocalIndices.begin(), chunkLocalIndices.end());
+
+        for (const auto localIndex : chunkLocalIndices)
+            growBounds(chunkResult._bounds, _positions[localIndex]);
+    }, result);
+}
@@ -0,0 +1,217 @@
+#pragma once
+
+#include "SpatialIndex.h"
+
+#include <graphics/Vector2f.h>
+
+#include <QImage>
+#include <QRect>
+#include <QRectF>
+#include <QSize>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+/**
+ * Selection mask class
+ *
+ * Packed 8-bit mask of a pixel selection area, restricted to the bounding rectangle of its
+ * non-transparent pixels, with a summed-area table so that the number of selected pixels in
+ * any screen rectangle can be looked up in constant time.
+ */
+class SelectionMask
+{
+public:
+
+    /**
+     * Construct from \p areaImage, clipped to \p screenRectangle
+     * @param areaImage Image of the pixel selection area
+     * @param screenRectangle Screen rectangle of the renderer
+     */
+    SelectionMask(const QImage& areaImage, const QRect& screenRectangle);
+
+    /**
+     * Get the mask of the pixels which are selected in either \p selectionMaskA or \p selectionMaskB, but not in both
+     * @param selectionMaskA First selection mask
+     * @param selectionMaskB Second selection mask
+     * @return Difference mask
+     */
+    static SelectionMask getDifference(const SelectionMask& selectionMaskA, const SelectionMask& selectionMaskB);
+
+    /** Determines whether the mask has no selected pixels */
+    bool isEmpty() const {
+        return _boundingRectangle.isEmpty();
+    }
+
+    /** Get the bounding rectangle of the selected pixels */
+    const QRect& getBoundingRectangle() const {
+        return _boundingRectangle;
+    }
+
+    /**
+     * Determines whether the pixel at \p x, \p y is selected
+     * @param x Pixel x-coordinate
+     * @param y Pixel y-coordinate
+     * @return Boolean determining whether the pixel is selected
+     */
+    bool contains(int x, int y) const {
+        const auto column   = static_cast<std::uint32_t>(x - _boundingRectangle.left());
+        const auto row      = static_cast<std::uint32_t>(y - _boundingRectangle.top());
+
+        if (column >= static_cast<std::uint32_t>(_boundingRectangle.width()) || row >= static_cast<std::uint32_t>(_boundingRectangle.height()))
+            return false;
+
+        return _pixels[static_cast<std::size_t>(row) * _boundingRectangle.width() + column] != 0;
+    }
+
+    /**
+     * Get the number of selected pixels in \p rectangle
+     * @param rectangle Screen rectangle
+     * @return Number of selected pixels
+     */
+    std::uint32_t count(const QRect& rectangle) const;
+
+private:
+
+    /** Construct an empty mask */
+    SelectionMask() = default;
+
+    /**
+     * Crop \p pixels to the bounding rectangle of the selected pixels and build the summed-area table
+     * @param rectangle Screen rectangle covered by \p pixels
+     * @param pixels Selected pixels (one byte per pixel) over \p rectangle
+     */
+    void initialize(const QRect& rectangle, const std::vector<std::uint8_t>& pixels);
+
+private:
+    QRect                       _boundingRectangle;     /** Bounding rectangle of the selected pixels */
+    std::vector<std::uint8_t>   _pixels;                /** Selected pixels (one byte per pixel) over the bounding rectangle */
+    std::vector<std::uint32_t>  _summedArea;            /** Summed-area table of selected pixels over the bounding rectangle */
+};
+
+/**
+ * Screen projection class
+ *
+ * Single precision mapping from world space to (renderer) screen space, which mirrors the way
+ * the scatterplot maps its zoom rectangle onto the render size.
+ */
+class ScreenProjection
+{
+public:
+
+    /**
+     * Construct from \p zoomRectangleWorld and \p screenSize
+     * @param zoomRectangleWorld Zoom rectangle in world space
+     * @param screenSize Size of the renderer in pixels
+     */
+    ScreenProjection(const QRectF& zoomRectangleWorld, const QSize& screenSize);
+
+    /** Get the screen x-coordinate of world x-coordinate \p x (clamped to just outside the screen, non-finite values map outside the screen) */
+    float getScreenX(float x) const {
+        return std::min(_screenWidth + 2.0f, std::max(-2.0f, (x - _worldLeft) * _scaleX));
+    }
+
+    /** Get the screen y-coordinate of world y-coordinate \p y (clamped to just outside the screen, non-finite values map outside the screen) */
+    float getScreenY(float y) const {
+        return std::min(_screenHeight + 2.0f, std::max(-2.0f, _screenHeight - (y - _worldTop) * _scaleY));
+    }
+
+    /**
+     * Get the world space rectangle covered by \p screenRectangle (padded by a pixel to be robust against truncation)
+     * @param screenRectangle Screen rectangle
+     * @return World space rectangle
+     */
+    SpatialIndex::Rectangle getWorldRectangle(const QRect& screenRectangle) const;
+
+    /**
+     * Get the screen footprint of \p worldRectangle (padded by a pixel to be robust against rounding)
+     * @param worldRectangle World space rectangle
+     * @return Screen rectangle
+     */
+    QRect getScreenRectangle(const SpatialIndex::Rectangle& worldRectangle) const;
+
+    /** Get the screen rectangle */
+    QRect getScreenRectangle() const;
+
+private:
+    float   _worldLeft;         /** Left of the zoom rectangle in world space */
+    float   _worldTop;          /** Top of the zoom rectangle in world space */
+    float   _scaleX;            /** Pixels per world unit in x-direction */
+    float   _scaleY;            /** Pixels per world unit in y-direction */
+    float   _screenWidth;       /** Width of the screen in pixels */
+    float   _screenHeight;      /** Height of the screen in pixels */
+
+public:
+
+    /** Determines whether two projections map world space to the same pixels */
+    bool operator==(const ScreenProjection& other) const = default;
+};
+
+/**
+ * Selection kernel class
+ *
+ * Determines which points are inside a selection mask. Positions are projected to screen space in
+ * batches (in a loop which the compiler can vectorize) and the point range is split over the
+ * global thread pool, with per-chunk index buffers and bounds which are merged at the end.
+ */
+class SelectionKernel
+{
+public:
+
+    /** Selected points */
+    struct Result {
+        std::vector<std::uint32_t>  _localIndices;      /** Sorted local indices of the selected points */
+        SpatialIndex::Rectangle     _bounds = {         /** World space bounds of the selected points (inverted when empty) */
+            std::numeric_limits<float>::max(),
+            std::numeric_limits<float>::lowest(),
+            std::numeric_limits<float>::max(),
+            std::numeric_limits<float>::lowest()
+        };
+    };
+
+public:
+
+    /**
+     * Construct with \p positions, \p selectionMask and \p screenProjection
+     * @param positions Point positions in world space
+     * @param selectionMask Selection mask in screen space
+     * @param screenProjection Mapping from world space to screen space
+     */
+    SelectionKernel(const std::vector<mv::Vector2f>& positions, const SelectionMask& selectionMask, const ScreenProjection& screenProjection);
+
+    /**
+     * Test only the points in grid cells which overlap the selection mask, cells whose screen
+     * footprint lies wholly inside or outside the selection mask are accepted or rejected in bulk
+     * @param spatialIndex Spatial index over the positions
+     * @return Selected points
+     */
+    Result select(const SpatialIndex& spatialIndex) const;
+
+private:
+
+    /**
+     * Test \p localIndices against the selection mask (in parallel)
+     * @param localIndices Local indices of the points to test
+     * @param result Result to append the selected points to
+     */
+    void testPoints(std::span<const std::uint32_t> localIndices, Result& result) const;
+
+    /**
+     * Select \p localIndices without testing (in parallel)
+     * @param localIndices Local indices of the points to select
+     * @param result Result to append the selected points to
+     */
+    void acceptPoints(std::span<const std::uint32_t> localIndices, Result& result) const;
+
+private:
+    const std::vector<mv::Vector2f>&    _positions;             /** Point positions in world space */
+    const SelectionMask&                _selectionMask;         /** Selection mask in screen space */
+    const ScreenProjection&             _screenProjection;      /** Mapping from world space to screen space */
+
+    static constexpr std::size_t    BATCH_SIZE              = 256;      /** Number of points projected at once */
+    static constexpr std::size_t    MINIMUM_CHUNK_SIZE      = 65536;    /** Minimum number of points processed by a single thread */
+    static constexpr std::size_t    DENSE_SELECTION_RATIO   = 16;       /** Selections larger than one in this many points are ordered by flagging instead of sorting */
+};
@@ -0,0 +1,153 @@
+#include "SelectionMerge.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <iterator>
+
+namespace
+{
+    // The bitset is preferred when the index range is at most this many times the (estimated) cost of a sorted merge
+    constexpr std::size_t BITSET_RANGE_FACTOR = 32;
+
+    // Returns a sorted copy of indices without duplicates
+    std::vector<std::uint32_t> getSortedUnique(const std::vector<std::uint32_t>& indices) {
+        auto sortedIndices = indices;
+
+        std::sort(sortedIndices.begin(), sortedIndices.end());
+
+        sortedIndices.erase(std::unique(sortedIndices.begin(), sortedIndices.end()), sortedIndices.end());
+
+        return sortedIndices;
+    }
+
+    // Returns one past the largest of indices (zero when empty)
+    std::size_t getRangeSize(const std::vector<std::uint32_t>& indices, bool indicesSorted) {
+        if (indices.empty())
+            return 0;
+
+        return static_cast<std::size_t>(indicesSorted ? indices.back() : *std::max_element(indices.begin(), indices.end())) + 1;
+    }
+
+    // Merges sorted currentIndices and newIndices, the current indices need to be free of duplicates (set_difference only removes one of them per new index)
+    std::vector<std::uint32_t> mergeSorted(const std::vector<std::uint32_t>& currentIndices, const std::vector<std::uint32_t>& newIndices, SelectionMergeOperation operation) {
+        std::vector<std::uint32_t> mergedIndices;
+
+        switch (operation)
+        {
+            case SelectionMergeOperation::Add:
+            {
+                mergedIndices.reserve(currentIndices.size() + newIndices.size());
+
+                std::set_union(currentIndices.begin(), currentIndices.end(), newIndices.begin(), newIndices.end(), std::back_inserter(mergedIndices));
+
+                // The new indices may contain duplicates
+                mergedIndices.erase(std::unique(mergedIndices.begin(), mergedIndices.end()), mergedIndices.end());
+
+                break;
+            }
+
+            case SelectionMergeOperation::Subtract:
+            {
+                mergedIndices.reserve(currentIndices.size());
+
+                std::set_difference(currentIndices.begin(), currentIndices.end(), newIndices.begin(), newIndices.end(), std::back_inserter(mergedIndices));
+
+                break;
+            }
+        }
+
+        return mergedIndices;
+    }
+
+    std::vector<std::uint32_t> mergeBitset(const std::vector<std::uint32_t>& currentIndices, const std::vector<std::uint32_t>& newIndices, SelectionMergeOperation operation, std::size_t rangeSize) {
+        std::vector<std::uint64_t> words((rangeSize + 63) / 64, 0);
+
+        for (const auto index : currentIndices)
+            words[index >> 6] |= std::uint64_t{ 1 } << (index & 63);
+
+        switch (operation)
+        {
+            case SelectionMergeOperation::Add:
+            {
+                for (const auto index : newIndices)
+                    words[index >> 6] |= std::uint64_t{ 1 } << (index & 63);
+
+                break;
+            }
+
+            case SelectionMergeOperation::Subtract:
+            {
+                for (const auto index : newIndices)
+                    words[index >> 6] &= ~(std::uint64_t{ 1 } << (index & 63));
+
+                break;
+            }
+        }
+
+        std::size_t numberOfMergedIndices = 0;
+
+        for (const auto word : words)
+            numberOfMergedIndices += static_cast<std::size_t>(std::popcount(word));
+
+        std::vector<std::uint32_t> mergedIndices;
+
+        mergedIndices.reserve(numberOfMergedIndices);
+
+        for (std::size_t wordIndex = 0; wordIndex < words.size(); wordIndex++) {
+            for (auto word = words[wordIndex]; word != 0; word &= word - 1)
+                mergedIndices.push_back(static_cast<std::uint32_t>(wordIndex * 64 + static_cast<std::size_t>(std::countr_zero(word))));
+        }
+
+        return mergedIndices;
+    }
+
+    // Applies operation with strategy, given whether the indices are sorted and one past their largest index
+    std::vector<std::uint32_t> mergeIndices(const std::vector<std::uint32_t>& currentIndices, const std::vector<std::uint32_t>& newIndices, SelectionMergeOperation operation, SelectionMergeStrategy strategy, bool currentIndicesSorted, bool newIndicesSorted, std::size_t rangeSize) {
+        switch (strategy)
+        {
+            case SelectionMergeStrategy::Bitset:
+                return mergeBitset(currentIndices, newIndices, operation, rangeSize);
+
+            case SelectionMergeStrategy::SortedMerge:
+                break;
+        }
+
+        // Only copy the indices which are not sorted (or, for the current indices, not free of duplicates) yet
+        const auto currentIndicesUnique = currentIndicesSorted && std::adjacent_find(currentIndices.begin(), currentIndices.end()) == currentIndices.end();
+
+        const auto sortedCurrentIndices = currentIndicesUnique ? std::vector<std::uint32_t>() : getSortedUnique(currentIndices);
+        const auto sortedNewIndices     = newIndicesSorted ? std::vector<std::uint32_t>() : getSortedUnique(newIndices);
+
+        return mergeSorted(currentIndicesUnique ? currentIndices : sortedCurrentIndices, newIndicesSorted ? newIndices : sortedNewIndices, operation);
+    }
+}
+
+SelectionMergeStrategy getSelectionMergeStrategy(std::size_t numberOfCurrentIndices, std::size_t numberOfNewIndices, std::size_t rangeSize, bool indicesSorted)
+{
+    auto sortedMergeCost = static_cast<double>(numberOfCurrentIndices + numberOfNewIndices);
+
+    if (!indicesSorted)
+        sortedMergeCost *= std::log2(sortedMergeCost + 2.0);
+
+    return static_cast<double>(rangeSize) <= sortedMergeCost * BITSET_RANGE_FACTOR ? SelectionMergeStrategy::Bitset : SelectionMergeStrategy::SortedMerge;
+}
+
+std::vector<std::uint32_t> mergeSelectionIndices(const std::vector<std::uint32_t>& currentIndices, const std::vector<std::uint32_t>& newIndices, SelectionMergeOperation operation)
+{
+    const auto currentIndicesSorted = std::is_sorted(currentIndices.begin(), currentIndices.end());
+    const auto newIndicesSorted     = std::is_sorted(newIndices.begin(), newIndices.end());
+    const auto rangeSize            = std::max(getRangeSize(currentIndices, currentIndicesSorted), getRangeSize(newIndices, newIndicesSorted));
+    const auto strategy             = getSelectionMergeStrategy(currentIndices.size(), newIndices.size(), rangeSize, currentIndicesSorted && newIndicesSorted);
+
+    return mergeIndices(currentIndices, newIndices, operation, strategy, currentIndicesSorted, newIndicesSorted, rangeSize);
+}
+
+std::vector<std::uint32_t> mergeSelectionIndices(const std::vector<std::uint32_t>& currentIndices, const std::vector<std::uint32_t>& newIndices, SelectionMergeOperation operation, SelectionMergeStrategy strategy)
+{
+    const auto currentIndicesSorted = std::is_sorted(currentIndices.begin(), currentIndices.end());
+    const auto newIndicesSorted     = std::is_sorted(newIndices.begin(), newIndices.end());
+    const auto rangeSize            = std::max(getRangeSize(currentIndices, currentIndicesSorted), getRangeSize(newIndices, newIndicesSorted));
+
+    return mergeIndices(currentIndices, newIndices, operation, strategy, currentIndicesSorted, newIndicesSorted, rangeSize);
+}
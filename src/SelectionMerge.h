@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Combining a current selection with newly selected (global) point indices, as done by the Add and Subtract pixel selection modifiers
+
+enum class SelectionMergeOperation {
+    Add,            /** Union of the current and new indices */
+    Subtract        /** Current indices which are not in the new indices */
+};
+
+enum class SelectionMergeStrategy {
+    SortedMerge,    /** Linear merge of sorted index vectors (for sparse selections) */
+    Bitset          /** Dense bitset over the index range (for large selections) */
+};
+
+// Returns the strategy which is cheapest for numberOfCurrentIndices and numberOfNewIndices out of an index range of rangeSize
+// The bitset is chosen when the selections occupy a considerable part of the index range, or when the indices would otherwise need sorting
+SelectionMergeStrategy getSelectionMergeStrategy(std::size_t numberOfCurrentIndices, std::size_t numberOfNewIndices, std::size_t rangeSize, bool indicesSorted);
+
+// Returns the sorted result of applying operation to currentIndices and newIndices (neither of which has to be sorted), the strategy is chosen automatically
+std::vector<std::uint32_t> mergeSelectionIndices(const std::vector<std::uint32_t>& currentIndices, const std::vector<std::uint32_t>& newIndices, SelectionMergeOperation operation);
+
+// Returns the sorted result of applying operation to currentIndices and newIndices (neither of which has to be sorted) with the given strategy
+std::vector<std::uint32_t> mergeSelectionIndices(const std::vector<std::uint32_t>& currentIndices, const std::vector<std::uint32_t>& newIndices, SelectionMergeOperation operation, SelectionMergeStrategy strategy);
@@ -0,0 +1,108 @@
+#include "SelectionPublisher.h"
+
+#include <CoreInterface.h>
+
+#include <algorithm>
+
+SelectionPublisher::SelectionPublisher(QObject* parent) :
+    QObject(parent),
+    _maximumRate(0),
+    _isStrokeActive(false),
+    _timer(),
+    _elapsedTimer(),
+    _pendingDataset(),
+    _pendingSelectionIndices(),
+    _hasPendingSelection(false),
+    _numberOfSelections(0),
+    _numberOfCoalescedSelections(0)
+{
+    _timer.setSingleShot(true);
+
+    connect(&_timer, &QTimer::timeout, this, &SelectionPublisher::flush);
+}
+
+void SelectionPublisher::setMaximumRate(std::int32_t maximumRate)
+{
+    _maximumRate = std::max(0, maximumRate);
+}
+
+void SelectionPublisher::publish(const mv::Dataset<Points>& positionDataset, std::vector<std::uint32_t> selectionIndices)
+{
+    if (_hasPendingSelection)
+        _numberOfCoalescedSelections++;
+
+    _numberOfSelections++;
+
+    _pendingDataset             = positionDataset;
+    _pendingSelectionIndices    = std::move(selectionIndices);
+    _hasPendingSelection        = true;
+
+    if (!_isStrokeActive || _maximumRate == 0 || !_elapsedTimer.isValid()) {
+        flush();
+        return;
+    }
+
+    const auto interval         = static_cast<qint64>(1000 / _maximumRate);
+    const auto elapsedInterval  = _elapsedTimer.elapsed();
+
+    if (elapsedInterval >= interval) {
+        flush();
+        return;
+    }
+
+    // Publish the most recent selection once the interval has passed
+    if (!_timer.isActive())
+        _timer.start(static_cast<int>(interval - elapsedInterval));
+}
+
+void SelectionPublisher::flush()
+{
+    _timer.stop();
+
+    if (!_hasPendingSelection)
+        return;
+
+    _hasPendingSelection = false;
+
+    _elapsedTimer.start();
+
+    if (!_pendingDataset.isValid())
+        return;
+
+    _pendingDataset->setSelectionIndices(_pendingSelectionIndices);
+
+    mv::events().notifyDatasetDataSelectionChanged(_pendingDataset->getSourceDataset<Points>());
+
+    _pendingSelectionIndices.clear();
+}
+
+bool SelectionPublisher::hasPendingSelection() const
+{
+    return _hasPendingSelection;
+}
+
+const std::vector<std::uint32_t>& SelectionPublisher::getPendingSelectionIndices() const
+{
+    return _pendingSelectionIndices;
+}
+
+void SelectionPublisher::beginStroke()
+{
+    flush();
+
+    _isStrokeActive                 = true;
+    _numberOfSelections             = 0;
+    _numberOfCoalescedSelections    = 0;
+}
+
+void SelectionPublisher::endStroke()
+{
+    flush();
+
+    if (!_isStrokeActive)
+        return;
+
+    _isStrokeActive = false;
+
+    emit strokeEnded(_numberOfSelections, _numberOfCoalescedSelections);
+}
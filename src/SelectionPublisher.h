@@ -0,0 +1,79 @@
+#pragma once
+
+#include <Dataset.h>
+#include <PointData/PointData.h>
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QTimer>
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * Selection publisher class
+ *
+ * Publishes selections of the position dataset (sets the selection indices and notifies linked views),
+ * coalescing the intermediate selections of a selection stroke in progress such that they are
+ * published at most at a configurable rate. The final selection of a stroke is always published.
+ */
+class SelectionPublisher : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    /**
+     * Construct with \p parent object
+     * @param parent Pointer to parent object
+     */
+    SelectionPublisher(QObject* parent = nullptr);
+
+    /**
+     * Set the maximum number of publications per second during a stroke
+     * @param maximumRate Maximum rate in Hz (zero publishes every selection)
+     */
+    void setMaximumRate(std::int32_t maximumRate);
+
+    /**
+     * Publish \p selectionIndices for \p positionDataset (deferred when a stroke is in progress and the maximum rate would be exceeded)
+     * @param positionDataset Smart pointer to the position dataset
+     * @param selectionIndices Selection indices
+     */
+    void publish(const mv::Dataset<Points>& positionDataset, std::vector<std::uint32_t> selectionIndices);
+
+    /** Publish the pending selection (if any) immediately */
+    void flush();
+
+    /** Determines whether a selection is waiting to be published */
+    bool hasPendingSelection() const;
+
+    /** Get the indices of the selection which is waiting to be published */
+    const std::vector<std::uint32_t>& getPendingSelectionIndices() const;
+
+    /** Begin a stroke, from now on selections are rate-limited */
+    void beginStroke();
+
+    /** End the stroke in progress, publishes the final selection */
+    void endStroke();
+
+signals:
+
+    /**
+     * Signals that a stroke ended
+     * @param numberOfSelections Number of selections during the stroke
+     * @param numberOfCoalescedSelections Number of selections which were superseded before they were published
+     */
+    void strokeEnded(std::uint32_t numberOfSelections, std::uint32_t numberOfCoalescedSelections);
+
+private:
+    std::int32_t                _maximumRate;                   /** Maximum number of publications per second during a stroke (zero for no limit) */
+    bool                        _isStrokeActive;                /** Whether a stroke is in progress */
+    QTimer                      _timer;                         /** Single shot timer for publishing a deferred selection */
+    QElapsedTimer               _elapsedTimer;                  /** Time since the last publication */
+    mv::Dataset<Points>         _pendingDataset;                /** Position dataset of the pending selection */
+    std::vector<std::uint32_t>  _pendingSelectionIndices;       /** Indices of the pending selection */
+    bool                        _hasPendingSelection;           /** Whether a selection is waiting to be published */
+    std::uint32_t               _numberOfSelections;            /** Number of selections during the current stroke */
+    std::uint32_t               _numberOfCoalescedSelections;   /** Number of superseded selections during the current stroke */
+};
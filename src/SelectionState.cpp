@@ -0,0 +1,100 @@
+#include "SelectionState.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace
+{
+    // Mask bits while patching the previous selection into the new one
+    constexpr char PREVIOUSLY_SELECTED  = 1;
+    constexpr char SELECTED             = 2;
+}
+
+bool SelectionState::update(const IndexMapping& indexMapping, const std::vector<std::uint32_t>& globalSelectionIndices)
+{
+    const auto numberOfPoints               = indexMapping.getNumberOfPoints();
+    const auto isGlobalSelectionEmpty       = globalSelectionIndices.empty();
+    const auto globalSelectionEmptyChanged  = isGlobalSelectionEmpty != _isGlobalSelectionEmpty;
+    const auto numberOfPointsChanged        = numberOfPoints != _mask.size();
+
+    _isGlobalSelectionEmpty = isGlobalSelectionEmpty;
+
+    // The previous selection only carries over when it is for the same points
+    if (numberOfPointsChanged) {
+        _mask.assign(numberOfPoints, 0);
+        _localIndices.clear();
+    }
+
+    std::swap(_localIndices, _previousLocalIndices);
+
+    _localIndices.clear();
+
+    for (const auto globalIndex : globalSelectionIndices) {
+        const auto localIndex = indexMapping.getLocalIndex(globalIndex);
+
+        if (localIndex == IndexMapping::INVALID_INDEX || (_mask[localIndex] & SELECTED))
+            continue;
+
+        _mask[localIndex] |= SELECTED;
+
+        _localIndices.push_back(localIndex);
+    }
+
+    // Only the points of the previous and the new selection need to be visited to settle the mask
+    std::uint32_t numberOfChangedPoints = 0;
+
+    for (const auto localIndex : _previousLocalIndices) {
+        if (_mask[localIndex] == PREVIOUSLY_SELECTED)
+            numberOfChangedPoints++;
+
+        _mask[localIndex] >>= 1;
+    }
+
+    for (const auto localIndex : _localIndices) {
+        if (_mask[localIndex] == SELECTED)
+            numberOfChangedPoints++;
+
+        _mask[localIndex] = 1;
+    }
+
+    if (!std::is_sorted(_localIndices.begin(), _localIndices.end())) {
+
+        // Large selections are ordered by scanning the mask, which is linear in the number of points
+        if (_localIndices.size() * DENSE_SELECTION_RATIO > numberOfPoints) {
+            _localIndices.clear();
+
+            for (std::uint32_t localIndex = 0; localIndex < numberOfPoints; localIndex++)
+                if (_mask[localIndex])
+                    _localIndices.push_back(localIndex);
+        }
+        else {
+            std::sort(_localIndices.begin(), _localIndices.end());
+        }
+    }
+
+    return numberOfPointsChanged || globalSelectionEmptyChanged || numberOfChangedPoints > 0;
+}
+
+void SelectionState::clear()
+{
+    _mask.clear();
+    _localIndices.clear();
+    _previousLocalIndices.clear();
+
+    _isGlobalSelectionEmpty = true;
+}
+
+std::uint32_t SelectionState::getNumberOfPoints() const
+{
+    return static_cast<std::uint32_t>(_mask.size());
+}
+
+const std::vector<char>& SelectionState::getMask() const
+{
+    return _mask;
+}
+
+const std::vector<std::uint32_t>& SelectionState::getLocalIndices() const
+{
+    return _localIndices;
+}
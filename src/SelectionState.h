@@ -0,0 +1,47 @@
+#pragma once
+
+#include "IndexMapping.h"
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * Selection state class
+ *
+ * Selection of the position dataset in local point indices, computed once per selection change and
+ * shared by everything which depends on it (highlights, point size/opacity scalars and the sampler).
+ * Updates patch the mask of the previous selection, so their cost is proportional to the size of
+ * the previous and the new selection instead of the number of points.
+ */
+class SelectionState
+{
+public:
+
+    /**
+     * Update from \p globalSelectionIndices
+     * @param indexMapping Local/global index mapping of the position dataset
+     * @param globalSelectionIndices Global indices of the selected points (indices which are not part of the position dataset are ignored)
+     * @return Whether the selection changed for this view (the local selection changed, or the global selection became (non-)empty)
+     */
+    bool update(const IndexMapping& indexMapping, const std::vector<std::uint32_t>& globalSelectionIndices);
+
+    /** Reset to an empty selection of zero points */
+    void clear();
+
+    /** Get the number of points in the position dataset */
+    std::uint32_t getNumberOfPoints() const;
+
+    /** Get the per-point selection mask (one for selected points, zero otherwise) */
+    const std::vector<char>& getMask() const;
+
+    /** Get the sorted local indices of the selected points */
+    const std::vector<std::uint32_t>& getLocalIndices() const;
+
+private:
+    std::vector<char>           _mask;                              /** Per-point selection mask */
+    std::vector<std::uint32_t>  _localIndices;                      /** Sorted local indices of the selected points */
+    std::vector<std::uint32_t>  _previousLocalIndices;              /** Local indices of the previous selection (kept to reuse its memory) */
+    bool                        _isGlobalSelectionEmpty = true;     /** Whether the global selection was empty in the last update */
+
+    static constexpr std::size_t DENSE_SELECTION_RATIO = 16;        /** Selections larger than one in this many points are ordered by scanning the mask instead of sorting */
+};
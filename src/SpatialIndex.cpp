@@ -0,0 +1,256 @@
+#include "SpatialIndex.h"
+#include "ColumnStatistics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+    // Squared distance from \p x, \p y to \p rectangle (zero inside)
+    float getDistanceSquared(const SpatialIndex::Rectangle& rectangle, float x, float y)
+    {
+        const auto deltaX = std::max({ rectangle._left - x, 0.0f, x - rectangle._right });
+        const auto deltaY = std::max({ rectangle._bottom - y, 0.0f, y - rectangle._top });
+
+        return deltaX * deltaX + deltaY * deltaY;
+    }
+}
+
+void SpatialIndex::build(const std::vector<mv::Vector2f>& positions)
+{
+    clear();
+
+    const auto numberOfPositions = static_cast<std::uint32_t>(positions.size());
+
+    if (positions.empty())
+        return;
+
+    const auto statisticsX = computeColumnStatistics(&positions.front().x, positions.size(), 2);
+    const auto statisticsY = computeColumnStatistics(&positions.front().y, positions.size(), 2);
+
+    if (!statisticsX.hasFiniteValues() || !statisticsY.hasFiniteValues())
+        return;
+
+    _bounds = { statisticsX._minimum, statisticsX._maximum, statisticsY._minimum, statisticsY._maximum };
+
+    // Estimate of the number of indexed positions (those with two finite coordinates), used to choose the grid resolution
+    const auto numberOfFinitePositions = static_cast<std::uint32_t>(std::min(statisticsX._numberOfFiniteValues, statisticsY._numberOfFiniteValues));
+
+    // Choose the grid resolution such that cells are roughly square and hold a handful of points on average
+    const auto width            = static_cast<double>(_bounds._right - _bounds._left);
+    const auto height           = static_cast<double>(_bounds._top - _bounds._bottom);
+    const auto numberOfCells    = std::clamp<double>(static_cast<double>(numberOfFinitePositions) / TARGET_POINTS_PER_CELL, 1.0, MAXIMUM_NUMBER_OF_CELLS);
+
+    if (width > 0.0 && height > 0.0) {
+        const auto aspectRatio = width / height;
+
+        _numberOfColumns    = static_cast<std::uint32_t>(std::clamp(std::sqrt(numberOfCells * aspectRatio), 1.0, numberOfCells));
+        _numberOfRows       = static_cast<std::uint32_t>(std::clamp(numberOfCells / _numberOfColumns, 1.0, numberOfCells));
+    }
+    else {
+        _numberOfColumns    = width > 0.0 ? static_cast<std::uint32_t>(numberOfCells) : 1;
+        _numberOfRows       = height > 0.0 ? static_cast<std::uint32_t>(numberOfCells) : 1;
+    }
+
+    _cellWidth  = width > 0.0 ? static_cast<float>(width / _numberOfColumns) : 0.0f;
+    _cellHeight = height > 0.0 ? static_cast<float>(height / _numberOfRows) : 0.0f;
+
+    // Counting sort of the local point indices by cell
+    std::vector<std::uint32_t> pointCells(numberOfPositions, std::numeric_limits<std::uint32_t>::max());
+
+    _cellOffsets.assign(static_cast<std::size_t>(_numberOfColumns) * _numberOfRows + 1, 0);
+
+    for (std::uint32_t localPointIndex = 0; localPointIndex < numberOfPositions; localPointIndex++) {
+        const auto& position = positions[localPointIndex];
+
+        if (!std::isfinite(position.x) || !std::isfinite(position.y))
+            continue;
+
+        pointCells[localPointIndex] = getRow(position.y) * _numberOfColumns + getColumn(position.x);
+
+        _cellOffsets[pointCells[localPointIndex] + 1]++;
+    }
+
+    for (std::size_t cellIndex = 1; cellIndex < _cellOffsets.size(); cellIndex++)
+        _cellOffsets[cellIndex] += _cellOffsets[cellIndex - 1];
+
+    _pointIndices.resize(_cellOffsets.back());
+
+    std::vector<std::uint32_t> cellCursors(_cellOffsets.begin(), _cellOffsets.end() - 1);
+
+    for (std::uint32_t localPointIndex = 0; localPointIndex < numberOfPositions; localPointIndex++) {
+        const auto cellIndex = pointCells[localPointIndex];
+
+        if (cellIndex == std::numeric_limits<std::uint32_t>::max())
+            continue;
+
+        _pointIndices[cellCursors[cellIndex]++] = localPointIndex;
+    }
+}
+
+void SpatialIndex::clear()
+{
+    _bounds             = {};
+    _numberOfColumns    = 0;
+    _numberOfRows       = 0;
+    _cellWidth          = 0.0f;
+    _cellHeight         = 0.0f;
+
+    _cellOffsets.clear();
+    _pointIndices.clear();
+
+    _cellOffsets.shrink_to_fit();
+    _pointIndices.shrink_to_fit();
+}
+
+bool SpatialIndex::isValid() const
+{
+    return _numberOfColumns > 0 && _numberOfRows > 0;
+}
+
+const SpatialIndex::Rectangle& SpatialIndex::getBounds() const
+{
+    return _bounds;
+}
+
+SpatialIndex::Rectangle SpatialIndex::getCellRectangle(std::uint32_t column, std::uint32_t row) const
+{
+    // The last column/row is closed at the bounds to be robust against rounding
+    return {
+        _bounds._left + static_cast<float>(column) * _cellWidth,
+        column + 1 == _numberOfColumns ? _bounds._right : _bounds._left + static_cast<float>(column + 1) * _cellWidth,
+        _bounds._bottom + static_cast<float>(row) * _cellHeight,
+        row + 1 == _numberOfRows ? _bounds._top : _bounds._bottom + static_cast<float>(row + 1) * _cellHeight
+    };
+}
+
+std::span<const std::uint32_t> SpatialIndex::getCellPointIndices(std::uint32_t column, std::uint32_t row) const
+{
+    const auto cellIndex = static_cast<std::size_t>(row) * _numberOfColumns + column;
+
+    return { _pointIndices.data() + _cellOffsets[cellIndex], _pointIndices.data() + _cellOffsets[cellIndex + 1] };
+}
+
+bool SpatialIndex::getCellRange(const Rectangle& rectangle, CellRange& cellRange) const
+{
+    if (!isValid())
+        return false;
+
+    if (rectangle._right < _bounds._left || rectangle._left > _bounds._right || rectangle._top < _bounds._bottom || rectangle._bottom > _bounds._top)
+        return false;
+
+    cellRange = {
+        getColumn(rectangle._left),
+        getColumn(rectangle._right),
+        getRow(rectangle._bottom),
+        getRow(rectangle._top)
+    };
+
+    return true;
+}
+
+std::vector<SpatialIndex::Neighbour> SpatialIndex::getNearestPoints(const std::vector<mv::Vector2f>& positions, const mv::Vector2f& position, std::size_t maximumNumberOfPoints, float maximumDistance, const std::function<bool(std::uint32_t)>& accept) const
+{
+    std::vector<Neighbour> neighbours;
+
+    if (!isValid() || maximumNumberOfPoints == 0 || !(maximumDistance >= 0.0f) || !std::isfinite(position.x) || !std::isfinite(position.y))
+        return neighbours;
+
+    // Distances are squared during the search, the neighbours form a max-heap on distance
+    const auto isCloser = [](const Neighbour& neighbourA, const Neighbour& neighbourB) -> bool {
+        return neighbourA._distance < neighbourB._distance;
+    };
+
+    const auto maximumDistanceSquared = maximumDistance * maximumDistance;
+
+    auto distanceSquaredThreshold = maximumDistanceSquared;
+
+    const auto visitCell = [&](std::uint32_t column, std::uint32_t row) -> float {
+        const auto cellDistanceSquared = getDistanceSquared(getCellRectangle(column, row), position.x, position.y);
+
+        if (cellDistanceSquared > distanceSquaredThreshold)
+            return cellDistanceSquared;
+
+        for (const auto localIndex : getCellPointIndices(column, row)) {
+            const auto deltaX           = positions[localIndex].x - position.x;
+            const auto deltaY           = positions[localIndex].y - position.y;
+            const auto distanceSquared  = deltaX * deltaX + deltaY * deltaY;
+
+            if (distanceSquared > distanceSquaredThreshold || !accept(localIndex))
+                continue;
+
+            neighbours.push_back({ distanceSquared, localIndex });
+
+            std::push_heap(neighbours.begin(), neighbours.end(), isCloser);
+
+            if (neighbours.size() > maximumNumberOfPoints) {
+                std::pop_heap(neighbours.begin(), neighbours.end(), isCloser);
+
+                neighbours.pop_back();
+            }
+
+            if (neighbours.size() == maximumNumberOfPoints)
+                distanceSquaredThreshold = std::min(maximumDistanceSquared, neighbours.front()._distance);
+        }
+
+        return cellDistanceSquared;
+    };
+
+    const auto centerColumn = static_cast<std::int64_t>(getColumn(position.x));
+    const auto centerRow    = static_cast<std::int64_t>(getRow(position.y));
+    const auto lastColumn   = static_cast<std::int64_t>(_numberOfColumns) - 1;
+    const auto lastRow      = static_cast<std::int64_t>(_numberOfRows) - 1;
+    const auto lastRing     = std::max({ centerColumn, lastColumn - centerColumn, centerRow, lastRow - centerRow });
+
+    // Rings are visited from the inside out, once the nearest cell of a ring is farther away than the
+    // current threshold, the cells of all outer rings are as well
+    for (std::int64_t ring = 0; ring <= lastRing; ring++) {
+        const auto columnBegin  = std::max<std::int64_t>(0, centerColumn - ring);
+        const auto columnEnd    = std::min(lastColumn, centerColumn + ring);
+        const auto rowBegin     = std::max<std::int64_t>(0, centerRow - ring);
+        const auto rowEnd       = std::min(lastRow, centerRow + ring);
+
+        auto ringDistanceSquared = std::numeric_limits<float>::max();
+
+        for (auto row = rowBegin; row <= rowEnd; row++) {
+            if (row == centerRow - ring || row == centerRow + ring) {
+                for (auto column = columnBegin; column <= columnEnd; column++)
+                    ringDistanceSquared = std::min(ringDistanceSquared, visitCell(static_cast<std::uint32_t>(column), static_cast<std::uint32_t>(row)));
+            }
+            else {
+                if (centerColumn - ring >= 0)
+                    ringDistanceSquared = std::min(ringDistanceSquared, visitCell(static_cast<std::uint32_t>(centerColumn - ring), static_cast<std::uint32_t>(row)));
+
+                if (ring > 0 && centerColumn + ring <= lastColumn)
+                    ringDistanceSquared = std::min(ringDistanceSquared, visitCell(static_cast<std::uint32_t>(centerColumn + ring), static_cast<std::uint32_t>(row)));
+            }
+        }
+
+        if (ringDistanceSquared > distanceSquaredThreshold)
+            break;
+    }
+
+    std::sort_heap(neighbours.begin(), neighbours.end(), isCloser);
+
+    for (auto& neighbour : neighbours)
+        neighbour._distance = std::sqrt(neighbour._distance);
+
+    return neighbours;
+}
+
+std::uint32_t SpatialIndex::getColumn(float x) const
+{
+    if (_cellWidth <= 0.0f || x <= _bounds._left)
+        return 0;
+
+    return std::min(_numberOfColumns - 1, static_cast<std::uint32_t>(std::min((x - _bounds._left) / _cellWidth, static_cast<float>(_numberOfColumns))));
+}
+
+std::uint32_t SpatialIndex::getRow(float y) const
+{
+    if (_cellHeight <= 0.0f || y <= _bounds._bottom)
+        return 0;
+
+    return std::min(_numberOfRows - 1, static_cast<std::uint32_t>(std::min((y - _bounds._bottom) / _cellHeight, static_cast<float>(_numberOfRows))));
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <graphics/Vector2f.h>
+
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <vector>
+
+/**
+ * Spatial index class
+ *
+ * Uniform grid over two-dimensional point positions (in world space). The local point
+ * indices are bucketed per cell in compressed row storage, so that spatial queries only
+ * visit the cells which overlap the region of interest instead of all points. Nearest
+ * neighbour queries visit rings of cells around the query position.
+ */
+class SpatialIndex
+{
+public:
+
+    /** Axis-aligned rectangle in world space */
+    struct Rectangle {
+        float   _left   = 0.0f;     /** Minimum x-coordinate */
+        float   _right  = 0.0f;     /** Maximum x-coordinate */
+        float   _bottom = 0.0f;     /** Minimum y-coordinate */
+        float   _top    = 0.0f;     /** Maximum y-coordinate */
+    };
+
+    /** Inclusive range of grid cells */
+    struct CellRange {
+        std::uint32_t   _columnBegin    = 0;    /** First column */
+        std::uint32_t   _columnEnd      = 0;    /** Last column (inclusive) */
+        std::uint32_t   _rowBegin       = 0;    /** First row */
+        std::uint32_t   _rowEnd         = 0;    /** Last row (inclusive) */
+    };
+
+    /** Point found by a nearest neighbour query */
+    struct Neighbour {
+        float           _distance   = 0.0f;     /** Distance to the query position in world space */
+        std::uint32_t   _localIndex = 0;        /** Local point index */
+    };
+
+public:
+
+    /**
+     * (Re)build the index for \p positions
+     * @param positions Point positions in world space (non-finite positions are not indexed)
+     */
+    void build(const std::vector<mv::Vector2f>& positions);
+
+    /** Release all cells */
+    void clear();
+
+    /** Determines whether the index contains any cells */
+    bool isValid() const;
+
+    /** Get the world space bounds of the indexed points */
+    const Rectangle& getBounds() const;
+
+    /**
+     * Get the world space rectangle covered by the cell at \p column and \p row
+     * @param column Column index
+     * @param row Row index
+     * @return Cell rectangle
+     */
+    Rectangle getCellRectangle(std::uint32_t column, std::uint32_t row) const;
+
+    /**
+     * Get the local indices of the points in the cell at \p column and \p row
+     * @param column Column index
+     * @param row Row index
+     * @return Span of local point indices
+     */
+    std::span<const std::uint32_t> getCellPointIndices(std::uint32_t column, std::uint32_t row) const;
+
+    /**
+     * Get the range of cells which overlap with \p rectangle
+     * @param rectangle Query rectangle in world space
+     * @param cellRange Range of overlapping cells (only valid when the function returns true)
+     * @return Boolean determining whether any cell overlaps with \p rectangle
+     */
+    bool getCellRange(const Rectangle& rectangle, CellRange& cellRange) const;
+
+    /**
+     * Get the (at most) \p maximumNumberOfPoints points nearest to \p position which are at most \p maximumDistance away from it
+     * (a k-nearest neighbour and a radius query in one), cells are visited in rings around \p position until no closer point can be found
+     * @param positions Point positions the index was built for
+     * @param position Query position in world space
+     * @param maximumNumberOfPoints Maximum number of points to return
+     * @param maximumDistance Maximum distance to \p position in world space
+     * @param accept Predicate on the local point index, points for which it returns false are skipped
+     * @return Nearest points, ordered by increasing distance
+     */
+    std::vector<Neighbour> getNearestPoints(const std::vector<mv::Vector2f>& positions, const mv::Vector2f& position, std::size_t maximumNumberOfPoints, float maximumDistance, const std::function<bool(std::uint32_t)>& accept) const;
+
+private:
+
+    /** Get the (clamped) column for world x-coordinate \p x */
+    std::uint32_t getColumn(float x) const;
+
+    /** Get the (clamped) row for world y-coordinate \p y */
+    std::uint32_t getRow(float y) const;
+
+private:
+    Rectangle                   _bounds;                /** World space bounds of the indexed points */
+    std::uint32_t               _numberOfColumns = 0;   /** Number of grid columns */
+    std::uint32_t               _numberOfRows = 0;      /** Number of grid rows */
+    float                       _cellWidth = 0.0f;      /** Width of a cell in world space */
+    float                       _cellHeight = 0.0f;     /** Height of a cell in world space */
+    std::vector<std::uint32_t>  _cellOffsets;           /** Offset of each cell in the point indices (number of cells + 1) */
+    std::vector<std::uint32_t>  _pointIndices;          /** Local point indices, ordered by cell */
+
+    static constexpr std::uint32_t  TARGET_POINTS_PER_CELL  = 16;           /** Average number of points per cell the grid resolution aims for */
+    static constexpr std::uint32_t  MAXIMUM_NUMBER_OF_CELLS = 2048 * 2048;  /** Upper bound on the number of grid cells */
+};
@@ -0,0 +1,174 @@
+#include "ColumnStatistics.h"
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace
+{
+    /** Get numberOfValues random values with NaNs and infinities spread over them */
+    std::vector<float> getValues(std::size_t numberOfValues, std::uint32_t seed)
+    {
+        std::mt19937 generator(seed);
+
+        std::uniform_real_distribution<float> distribution(-1000.0f, 1000.0f);
+
+        std::vector<float> values(numberOfValues);
+
+        for (auto& value : values)
+            value = distribution(generator);
+
+        for (std::size_t index = 0; index < numberOfValues; index += 1009)
+            values[index] = std::numeric_limits<float>::quiet_NaN();
+
+        for (std::size_t index = 500; index < numberOfValues; index += 4001)
+            values[index] = index % 2 ? std::numeric_limits<float>::infinity() : -std::numeric_limits<float>::infinity();
+
+        return values;
+    }
+
+    /** Serial reference */
+    ColumnStatistics computeSerially(const float* values, std::size_t count, std::size_t stride)
+    {
+        ColumnStatistics statistics;
+
+        for (std::size_t index = 0; index < count; index++) {
+            const auto value = values[index * stride];
+
+            if (std::isnan(value)) {
+                statistics._numberOfNaNs++;
+            }
+            else if (std::isinf(value)) {
+                statistics._numberOfInfinities++;
+            }
+            else {
+                statistics._minimum = std::min(statistics._minimum, value);
+                statistics._maximum = std::max(statistics._maximum, value);
+                statistics._sum += value;
+                statistics._numberOfFiniteValues++;
+            }
+        }
+
+        return statistics;
+    }
+
+    /** Check \p statistics against \p expected (the sum up to rounding) */
+    void requireEqual(const ColumnStatistics& statistics, const ColumnStatistics& expected)
+    {
+        REQUIRE(statistics._minimum == expected._minimum);
+        REQUIRE(statistics._maximum == expected._maximum);
+        REQUIRE(statistics._numberOfFiniteValues == expected._numberOfFiniteValues);
+        REQUIRE(statistics._numberOfNaNs == expected._numberOfNaNs);
+        REQUIRE(statistics._numberOfInfinities == expected._numberOfInfinities);
+        REQUIRE(statistics._sum == Approx(expected._sum).epsilon(1e-5).margin(1.0));
+    }
+}
+
+TEST_CASE("Column statistics match the serial reference", "[ColumnStatistics]")
+{
+    const auto values = getValues(2'000'003, 1);
+
+    SECTION("Contiguous") {
+        requireEqual(computeColumnStatistics(values.data(), values.size()), computeSerially(values.data(), values.size(), 1));
+    }
+
+    SECTION("Strided") {
+        for (std::size_t offset = 0; offset < 3; offset++)
+            requireEqual(computeColumnStatistics(values.data() + offset, values.size() / 3, 3), computeSerially(values.data() + offset, values.size() / 3, 3));
+    }
+
+    SECTION("Shorter than a block") {
+        requireEqual(computeColumnStatistics(values.data(), 13), computeSerially(values.data(), 13, 1));
+    }
+}
+
+TEST_CASE("Column statistics of a column without finite values", "[ColumnStatistics]")
+{
+    const std::vector<float> values = { std::numeric_limits<float>::quiet_NaN(), std::numeric_limits<float>::infinity() };
+
+    const auto statistics = computeColumnStatistics(values.data(), values.size());
+
+    REQUIRE_FALSE(statistics.hasFiniteValues());
+    REQUIRE(statistics.getNumberOfNonFiniteValues() == 2);
+    REQUIRE(statistics.getMean() == 0.0);
+    REQUIRE_FALSE(computeColumnStatistics(values.data(), 0).hasFiniteValues());
+}
+
+TEST_CASE("Column percentiles are within a histogram bin of the exact percentiles", "[ColumnStatistics]")
+{
+    const auto values       = getValues(2'000'003, 3);
+    const auto getValue     = [&values](std::size_t index) -> float { return values[index]; };
+    const auto statistics   = computeColumnStatistics(values.size(), getValue);
+    const auto percentiles  = computeColumnPercentiles(values.size(), getValue, statistics);
+
+    std::vector<float> finiteValues;
+
+    std::copy_if(values.begin(), values.end(), std::back_inserter(finiteValues), [](float value) { return std::isfinite(value); });
+    std::sort(finiteValues.begin(), finiteValues.end());
+
+    REQUIRE(percentiles.size() == COLUMN_PERCENTILES.size());
+
+    const auto binWidth = (statistics._maximum - statistics._minimum) / static_cast<float>(COLUMN_PERCENTILES_NUMBER_OF_BINS);
+
+    for (std::size_t percentileIndex = 0; percentileIndex < COLUMN_PERCENTILES.size(); percentileIndex++) {
+        const auto rank = static_cast<std::size_t>(std::round(COLUMN_PERCENTILES[percentileIndex] / 100.0 * static_cast<double>(finiteValues.size() - 1)));
+
+        REQUIRE(percentiles[percentileIndex] == Approx(finiteValues[rank]).margin(binWidth));
+    }
+
+    SECTION("Constant column") {
+        const std::vector<float> constantValues(1000, 4.0f);
+
+        const auto constantPercentiles = computeColumnPercentiles(constantValues.size(), [&constantValues](std::size_t index) -> float { return constantValues[index]; }, computeColumnStatistics(constantValues.data(), constantValues.size()));
+
+        REQUIRE(constantPercentiles == std::vector<float>(COLUMN_PERCENTILES.size(), 4.0f));
+    }
+
+    SECTION("Column without finite values") {
+        const std::vector<float> nonFiniteValues = { std::numeric_limits<float>::quiet_NaN(), std::numeric_limits<float>::infinity() };
+
+        const auto nonFiniteGetValue = [&nonFiniteValues](std::size_t index) -> float { return nonFiniteValues[index]; };
+
+        REQUIRE(computeColumnPercentiles(nonFiniteValues.size(), nonFiniteGetValue, computeColumnStatistics(nonFiniteValues.size(), nonFiniteGetValue)).empty());
+    }
+}
+
+TEST_CASE("ColumnStatistics benchmark", "[.benchmark][ColumnStatistics]")
+{
+    const auto values = getValues(20'000'000, 2);
+
+    BENCHMARK("Serial minimum and maximum (previous loop)") {
+        auto minimum = std::numeric_limits<float>::max();
+        auto maximum = std::numeric_limits<float>::lowest();
+
+        for (const auto value : values) {
+            minimum = std::min(minimum, value);
+            maximum = std::max(maximum, value);
+        }
+
+        return minimum + maximum;
+    };
+
+    BENCHMARK("Column statistics") {
+        return computeColumnStatistics(values.data(), values.size());
+    };
+
+    BENCHMARK("Column statistics (one of two interleaved columns)") {
+        return computeColumnStatistics(values.data(), values.size() / 2, 2);
+    };
+
+    BENCHMARK("Column statistics with percentiles") {
+        const auto getValue = [&values](std::size_t index) -> float { return values[index]; };
+
+        auto statistics = computeColumnStatistics(values.size(), getValue);
+
+        statistics._percentiles = computeColumnPercentiles(values.size(), getValue, statistics);
+
+        return statistics;
+    };
+}
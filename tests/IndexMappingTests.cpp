@@ -0,0 +1,82 @@
+#include "IndexMapping.h"
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    /** Get numberOfPoints distinct global indices, shuffled, out of a global index range of rangeSize */
+    std::vector<std::uint32_t> getGlobalIndices(std::uint32_t numberOfPoints, std::uint32_t rangeSize, std::uint32_t seed)
+    {
+        std::mt19937 generator(seed);
+
+        std::vector<std::uint32_t> globalIndices(rangeSize);
+
+        std::iota(globalIndices.begin(), globalIndices.end(), 0);
+        std::shuffle(globalIndices.begin(), globalIndices.end(), generator);
+
+        globalIndices.resize(numberOfPoints);
+
+        return globalIndices;
+    }
+
+    /** Check the reverse lookup of \p indexMapping against a hash map over the whole global index range */
+    void requireLocalIndices(const IndexMapping& indexMapping, const std::vector<std::uint32_t>& globalIndices, std::uint32_t rangeSize)
+    {
+        std::unordered_map<std::uint32_t, std::uint32_t> expectedLocalIndices;
+
+        for (std::uint32_t localIndex = 0; localIndex < globalIndices.size(); localIndex++)
+            expectedLocalIndices[globalIndices[localIndex]] = localIndex;
+
+        for (std::uint32_t globalIndex = 0; globalIndex < rangeSize + 10; globalIndex++) {
+            const auto it = expectedLocalIndices.find(globalIndex);
+
+            REQUIRE(indexMapping.getLocalIndex(globalIndex) == (it != expectedLocalIndices.end() ? it->second : IndexMapping::INVALID_INDEX));
+        }
+
+        for (std::uint32_t localIndex = 0; localIndex < globalIndices.size(); localIndex++)
+            REQUIRE(indexMapping.getGlobalIndex(localIndex) == globalIndices[localIndex]);
+    }
+}
+
+TEST_CASE("Dense and sparse reverse lookups match a hash map", "[IndexMapping]")
+{
+    // A subset covering most of the global range (dense lookup) and one covering a small part of it (sparse lookup)
+    for (const auto& [numberOfPoints, rangeSize] : { std::pair{ 80'000u, 100'000u }, std::pair{ 5'000u, 100'000u } }) {
+        const auto globalIndices = getGlobalIndices(numberOfPoints, rangeSize, numberOfPoints);
+
+        IndexMapping indexMapping;
+
+        indexMapping.update(globalIndices);
+
+        REQUIRE(indexMapping.isValid());
+        REQUIRE(indexMapping.getNumberOfPoints() == numberOfPoints);
+        REQUIRE(indexMapping.getGlobalIndices() == globalIndices);
+
+        requireLocalIndices(indexMapping, globalIndices, rangeSize);
+    }
+}
+
+TEST_CASE("An invalidated mapping is empty", "[IndexMapping]")
+{
+    IndexMapping indexMapping;
+
+    indexMapping.update(getGlobalIndices(100, 200, 1));
+    indexMapping.invalidate();
+
+    REQUIRE_FALSE(indexMapping.isValid());
+    REQUIRE(indexMapping.getNumberOfPoints() == 0);
+    REQUIRE(indexMapping.getLocalIndex(0) == IndexMapping::INVALID_INDEX);
+
+    indexMapping.update(std::vector<std::uint32_t>());
+
+    REQUIRE(indexMapping.isValid());
+    REQUIRE(indexMapping.getLocalIndex(0) == IndexMapping::INVALID_INDEX);
+}
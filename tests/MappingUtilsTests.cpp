@@ -0,0 +1,124 @@
+#include "MappingUtils.h"
+#include "ParallelUtils.h"
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using LinkedMap = std::map<std::uint32_t, std::vector<std::uint32_t>>;
+
+    /** Get a map from numberOfKeys (sparse) keys to valuesPerKey random targets each, every target except skippedTarget is hit */
+    LinkedMap getLinkedMap(std::uint32_t numberOfKeys, std::uint32_t valuesPerKey, std::uint32_t numPointsInTarget, std::int64_t skippedTarget, std::uint32_t seed)
+    {
+        std::mt19937 generator(seed);
+
+        std::uniform_int_distribution<std::uint32_t> distribution(0, numPointsInTarget + numPointsInTarget / 10);
+
+        LinkedMap linkedMap;
+
+        for (std::uint32_t keyIndex = 0; keyIndex < numberOfKeys; keyIndex++) {
+            auto& values = linkedMap[keyIndex * 3];
+
+            // Cover each target once, spread over the keys
+            for (std::uint32_t target = keyIndex; target < numPointsInTarget; target += numberOfKeys)
+                if (target != skippedTarget)
+                    values.push_back(target);
+
+            // Add random (also out of range) targets
+            for (std::uint32_t valueIndex = 0; valueIndex < valuesPerKey; valueIndex++) {
+                const auto target = distribution(generator);
+
+                if (target != skippedTarget)
+                    values.push_back(target);
+            }
+        }
+
+        return linkedMap;
+    }
+
+    /** Serial reference */
+    bool checkSurjectiveMappingSerially(const LinkedMap& linkedMap, std::uint32_t numPointsInTarget)
+    {
+        std::vector<bool> found(numPointsInTarget, false);
+
+        std::uint32_t count = 0;
+
+        for (const auto& [key, values] : linkedMap)
+            for (const auto value : values)
+                if (value < numPointsInTarget && !found[value]) {
+                    found[value] = true;
+                    count++;
+                }
+
+        return numPointsInTarget > 0 && count == numPointsInTarget;
+    }
+}
+
+TEST_CASE("Chunked surjectivity checks match the serial reference", "[MappingUtils]")
+{
+    constexpr std::uint32_t numPointsInTarget = 300'000;
+
+    for (const std::int64_t skippedTarget : { std::int64_t{ -1 }, std::int64_t{ 0 }, std::int64_t{ 123'457 }, std::int64_t{ numPointsInTarget - 1 } }) {
+        const auto linkedMap    = getLinkedMap(100'000, 2, numPointsInTarget, skippedTarget, 1);
+        const auto expected     = checkSurjectiveMappingSerially(linkedMap, numPointsInTarget);
+
+        REQUIRE(expected == (skippedTarget < 0));
+
+        for (const std::size_t numberOfChunks : { 1, 2, 3, 8, 64 })
+            REQUIRE(checkSurjectiveMapping(linkedMap, numPointsInTarget, numberOfChunks) == expected);
+    }
+}
+
+TEST_CASE("Mappings with fewer values than target points are not surjective", "[MappingUtils]")
+{
+    const LinkedMap linkedMap = { { 0, { 0, 1 } }, { 5, { 2 } } };
+
+    for (const std::size_t numberOfChunks : { 1, 2, 4 }) {
+        REQUIRE(checkSurjectiveMapping(linkedMap, 3, numberOfChunks));
+        REQUIRE_FALSE(checkSurjectiveMapping(linkedMap, 4, numberOfChunks));
+    }
+}
+
+TEST_CASE("Empty targets and empty mappings are not surjective", "[MappingUtils]")
+{
+    const LinkedMap linkedMap = { { 0, { 0 } } };
+
+    for (const std::size_t numberOfChunks : { 1, 4 }) {
+        REQUIRE_FALSE(checkSurjectiveMapping(linkedMap, 0, numberOfChunks));
+        REQUIRE_FALSE(checkSurjectiveMapping(LinkedMap(), 1, numberOfChunks));
+        REQUIRE_FALSE(checkSurjectiveMapping(LinkedMap(), 0, numberOfChunks));
+    }
+}
+
+TEST_CASE("MappingUtils benchmark", "[.benchmark][MappingUtils]")
+{
+    for (const std::uint32_t numberOfEntries : { 1'000'000u, 10'000'000u }) {
+        const auto numPointsInTarget    = numberOfEntries / 2;
+        const auto surjectiveMap        = getLinkedMap(numberOfEntries / 10, 5, numPointsInTarget, -1, 2);
+        const auto nonSurjectiveMap     = getLinkedMap(numberOfEntries / 10, 5, numPointsInTarget, numPointsInTarget / 2, 3);
+        const auto numberOfChunks       = std::min<std::size_t>(getNumberOfChunks(surjectiveMap.size(), SURJECTIVITY_CHECK_MINIMUM_CHUNK_SIZE), std::max(1, QThread::idealThreadCount()));
+
+        BENCHMARK("Serial reference, surjective, " + std::to_string(numberOfEntries) + " entries") {
+            return checkSurjectiveMappingSerially(surjectiveMap, numPointsInTarget);
+        };
+
+        BENCHMARK("Serial reference, not surjective, " + std::to_string(numberOfEntries) + " entries") {
+            return checkSurjectiveMappingSerially(nonSurjectiveMap, numPointsInTarget);
+        };
+
+        BENCHMARK("Surjectivity check, surjective, " + std::to_string(numberOfEntries) + " entries") {
+            return checkSurjectiveMapping(surjectiveMap, numPointsInTarget, numberOfChunks);
+        };
+
+        BENCHMARK("Surjectivity check, not surjective, " + std::to_string(numberOfEntries) + " entries") {
+            return checkSurjectiveMapping(nonSurjectiveMap, numPointsInTarget, numberOfChunks);
+        };
+    }
+}
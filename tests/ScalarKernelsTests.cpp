@@ -0,0 +1,114 @@
+#include "ScalarKernels.h"
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    /** Get numberOfValues random values, partly outside of [0, 10] */
+    std::vector<float> getValues(std::size_t numberOfValues, std::uint32_t seed)
+    {
+        std::mt19937 generator(seed);
+
+        std::uniform_real_distribution<float> distribution(-2.0f, 12.0f);
+
+        std::vector<float> values(numberOfValues);
+
+        for (auto& value : values)
+            value = distribution(generator);
+
+        return values;
+    }
+
+    /** Serial reference of computeNormalizedScalars */
+    float getNormalizedScalar(float value, float rangeMin, float rangeMax, float offset, float scale)
+    {
+        const auto valueClamped = std::max(rangeMin, std::min(rangeMax, value));
+
+        return offset + scale * ((valueClamped - rangeMin) / (rangeMax - rangeMin));
+    }
+}
+
+TEST_CASE("Normalized scalars match the serial loop", "[ScalarKernels]")
+{
+    const auto values = getValues(1'000'003, 1);
+
+    std::vector<float> scalars(values.size());
+
+    computeNormalizedScalars(values, scalars, 0.0f, 10.0f, 3.0f, 20.0f);
+
+    for (std::size_t pointIndex = 0; pointIndex < values.size(); pointIndex++)
+        REQUIRE(scalars[pointIndex] == Approx(getNormalizedScalar(values[pointIndex], 0.0f, 10.0f, 3.0f, 20.0f)).margin(1e-4));
+}
+
+TEST_CASE("Opacity scalars match the serial loop", "[ScalarKernels]")
+{
+    const auto values = getValues(1'000'003, 2);
+
+    std::vector<float> scalars(values.size());
+
+    SECTION("Partial offset") {
+        const auto magnitude    = 0.8f;
+        const auto offset       = 0.25f;
+
+        computeOpacityScalars(values, scalars, 0.0f, 10.0f, magnitude, offset);
+
+        for (std::size_t pointIndex = 0; pointIndex < values.size(); pointIndex++)
+            REQUIRE(scalars[pointIndex] == Approx(magnitude * (offset + getNormalizedScalar(values[pointIndex], 0.0f, 10.0f, 0.0f, 1.0f) / (1.0f - offset))).margin(1e-5));
+    }
+
+    SECTION("Full offset") {
+        computeOpacityScalars(values, scalars, 0.0f, 10.0f, 0.5f, 1.0f);
+
+        REQUIRE(std::all_of(scalars.begin(), scalars.end(), [](float scalar) -> bool { return scalar == 1.0f; }));
+    }
+}
+
+TEST_CASE("The maximum normalized scalar is found without scanning the scalars", "[ScalarKernels]")
+{
+    const auto values       = getValues(100'000, 3);
+    const auto statistics   = computeColumnStatistics(values.data(), values.size());
+
+    std::vector<float> scalars(values.size());
+
+    for (const auto& [rangeMin, rangeMax] : { std::pair{ 0.0f, 10.0f }, std::pair{ -5.0f, 20.0f }, std::pair{ 4.0f, 5.0f } }) {
+        computeNormalizedScalars(values, scalars, rangeMin, rangeMax, 1.0f, 15.0f);
+
+        REQUIRE(getMaximumNormalizedScalar(statistics, rangeMin, rangeMax, 1.0f, 15.0f) == Approx(*std::max_element(scalars.begin(), scalars.end())));
+    }
+}
+
+TEST_CASE("ScalarKernels benchmark", "[.benchmark][ScalarKernels]")
+{
+    const auto values = getValues(20'000'000, 4);
+
+    std::vector<float> scalars(values.size());
+
+    BENCHMARK("Serial point size loop (previous loop)") {
+        for (std::size_t pointIndex = 0; pointIndex < values.size(); pointIndex++) {
+            const auto pointValueClamped = std::max(0.0f, std::min(10.0f, values[pointIndex]));
+
+            scalars[pointIndex] = 3.0f + 20.0f * ((pointValueClamped - 0.0f) / 10.0f);
+        }
+
+        return scalars.back();
+    };
+
+    BENCHMARK("Point size kernel") {
+        computeNormalizedScalars(values, scalars, 0.0f, 10.0f, 3.0f, 20.0f);
+
+        return scalars.back();
+    };
+
+    BENCHMARK("Opacity kernel") {
+        computeOpacityScalars(values, scalars, 0.0f, 10.0f, 0.8f, 0.25f);
+
+        return scalars.back();
+    };
+}
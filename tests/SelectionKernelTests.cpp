@@ -0,0 +1,196 @@
+#include "SelectionKernel.h"
+#include "SpatialIndex.h"
+
+#include <catch2/catch.hpp>
+
+#include <QImage>
+#include <QPointF>
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace
+{
+    constexpr int SCREEN_WIDTH  = 800;
+    constexpr int SCREEN_HEIGHT = 600;
+
+    /** Get an alpha image of the screen with a disk and a scattering of random blocks selected */
+    QImage getAreaImage(std::uint32_t seed)
+    {
+        QImage areaImage(SCREEN_WIDTH, SCREEN_HEIGHT, QImage::Format_Alpha8);
+
+        areaImage.fill(0);
+
+        std::mt19937 generator(seed);
+
+        std::uniform_int_distribution<int> xDistribution(0, SCREEN_WIDTH - 1), yDistribution(0, SCREEN_HEIGHT - 1), sizeDistribution(1, 40);
+
+        for (int y = 0; y < SCREEN_HEIGHT; y++) {
+            auto scanLine = areaImage.scanLine(y);
+
+            for (int x = 0; x < SCREEN_WIDTH; x++)
+                if ((x - 300) * (x - 300) + (y - 250) * (y - 250) < 150 * 150)
+                    scanLine[x] = 255;
+        }
+
+        for (int blockIndex = 0; blockIndex < 50; blockIndex++) {
+            const auto left     = xDistribution(generator);
+            const auto top      = yDistribution(generator);
+            const auto size     = sizeDistribution(generator);
+
+            for (int y = top; y < std::min(top + size, SCREEN_HEIGHT); y++)
+                for (int x = left; x < std::min(left + size, SCREEN_WIDTH); x++)
+                    areaImage.scanLine(y)[x] = 128;
+        }
+
+        return areaImage;
+    }
+
+    /** Get uniformly distributed positions around the unit square (which is on screen), with a few non-finite ones */
+    std::vector<mv::Vector2f> getPositions(std::size_t numberOfPoints, std::uint32_t seed)
+    {
+        std::mt19937 generator(seed);
+
+        std::uniform_real_distribution<float> distribution(-0.2f, 1.2f);
+
+        std::vector<mv::Vector2f> positions(numberOfPoints);
+
+        for (auto& position : positions)
+            position = mv::Vector2f(distribution(generator), distribution(generator));
+
+        for (std::size_t pointIndex = 0; pointIndex < numberOfPoints; pointIndex += 9973)
+            positions[pointIndex] = mv::Vector2f(std::numeric_limits<float>::quiet_NaN(), 0.5f);
+
+        return positions;
+    }
+
+    /** Serial reference: test every point against the mask in the same way as the kernel */
+    std::vector<std::uint32_t> selectSerially(const std::vector<mv::Vector2f>& positions, const SelectionMask& selectionMask, const ScreenProjection& screenProjection)
+    {
+        std::vector<std::uint32_t> localIndices;
+
+        for (std::uint32_t localIndex = 0; localIndex < positions.size(); localIndex++) {
+            const auto screenX = static_cast<int>(screenProjection.getScreenX(positions[localIndex].x));
+            const auto screenY = static_cast<int>(screenProjection.getScreenY(positions[localIndex].y));
+
+            if (selectionMask.contains(screenX, screenY))
+                localIndices.push_back(localIndex);
+        }
+
+        return localIndices;
+    }
+}
+
+TEST_CASE("SelectionMask counts the selected pixels of any rectangle", "[SelectionMask]")
+{
+    const auto screenRectangle  = QRect(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT);
+    const auto selectionMask    = SelectionMask(getAreaImage(1), screenRectangle);
+
+    REQUIRE_FALSE(selectionMask.isEmpty());
+    REQUIRE(screenRectangle.contains(selectionMask.getBoundingRectangle()));
+
+    std::mt19937 generator(2);
+
+    std::uniform_int_distribution<int> xDistribution(-50, SCREEN_WIDTH + 50), yDistribution(-50, SCREEN_HEIGHT + 50);
+
+    for (int rectangleIndex = 0; rectangleIndex < 200; rectangleIndex++) {
+        const auto rectangle = QRect(QPoint(xDistribution(generator), yDistribution(generator)), QSize(xDistribution(generator) / 4, yDistribution(generator) / 4));
+
+        std::uint32_t expectedCount = 0;
+
+        for (int y = rectangle.top(); y <= rectangle.bottom(); y++)
+            for (int x = rectangle.left(); x <= rectangle.right(); x++)
+                expectedCount += selectionMask.contains(x, y);
+
+        REQUIRE(selectionMask.count(rectangle) == expectedCount);
+    }
+}
+
+TEST_CASE("SelectionMask difference holds the pixels selected in one mask only", "[SelectionMask]")
+{
+    const auto screenRectangle  = QRect(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT);
+    const auto selectionMaskA   = SelectionMask(getAreaImage(3), screenRectangle);
+    const auto selectionMaskB   = SelectionMask(getAreaImage(4), screenRectangle);
+    const auto difference       = SelectionMask::getDifference(selectionMaskA, selectionMaskB);
+
+    for (int y = -1; y <= SCREEN_HEIGHT; y++)
+        for (int x = -1; x <= SCREEN_WIDTH; x++)
+            REQUIRE(difference.contains(x, y) == (selectionMaskA.contains(x, y) != selectionMaskB.contains(x, y)));
+
+    REQUIRE(SelectionMask::getDifference(selectionMaskA, selectionMaskA).isEmpty());
+}
+
+TEST_CASE("SelectionKernel selects the same points as the serial loop", "[SelectionKernel]")
+{
+    const auto screenRectangle  = QRect(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT);
+    const auto screenProjection = ScreenProjection(QRectF(0.0, 0.0, 1.0, 1.0), screenRectangle.size());
+    const auto positions        = getPositions(500'000, 5);
+
+    SpatialIndex spatialIndex;
+
+    spatialIndex.build(positions);
+
+    for (const auto seed : { 6u, 7u }) {
+        const auto selectionMask    = SelectionMask(getAreaImage(seed), screenRectangle);
+        const auto result           = SelectionKernel(positions, selectionMask, screenProjection).select(spatialIndex);
+        const auto expected         = selectSerially(positions, selectionMask, screenProjection);
+
+        REQUIRE(result._localIndices == expected);
+
+        SpatialIndex::Rectangle expectedBounds = SelectionKernel::Result()._bounds;
+
+        for (const auto localIndex : expected) {
+            expectedBounds._left    = std::min(expectedBounds._left, positions[localIndex].x);
+            expectedBounds._right   = std::max(expectedBounds._right, positions[localIndex].x);
+            expectedBounds._bottom  = std::min(expectedBounds._bottom, positions[localIndex].y);
+            expectedBounds._top     = std::max(expectedBounds._top, positions[localIndex].y);
+        }
+
+        REQUIRE(result._bounds._left == expectedBounds._left);
+        REQUIRE(result._bounds._right == expectedBounds._right);
+        REQUIRE(result._bounds._bottom == expectedBounds._bottom);
+        REQUIRE(result._bounds._top == expectedBounds._top);
+    }
+}
+
+TEST_CASE("SelectionKernel benchmark", "[.benchmark][SelectionKernel]")
+{
+    const auto screenRectangle      = QRect(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT);
+    const auto zoomRectangleWorld   = QRectF(0.0, 0.0, 1.0, 1.0);
+    const auto screenProjection     = ScreenProjection(zoomRectangleWorld, screenRectangle.size());
+    const auto selectionAreaImage   = getAreaImage(8);
+    const auto positions            = getPositions(10'000'000, 9);
+
+    SpatialIndex spatialIndex;
+
+    spatialIndex.build(positions);
+
+    BENCHMARK("Per-pixel color lookup (previous loop)") {
+        std::vector<std::uint32_t> localIndices;
+
+        for (std::uint32_t localPointIndex = 0; localPointIndex < positions.size(); localPointIndex++) {
+            const auto& point = positions[localPointIndex];
+
+            const auto pointOffsetWorld             = QPointF(point.x - zoomRectangleWorld.left(), point.y - zoomRectangleWorld.top());
+            const auto pointOffsetWorldNormalized   = QPointF(pointOffsetWorld.x() / zoomRectangleWorld.width(), pointOffsetWorld.y() / zoomRectangleWorld.height());
+            const auto pointOffsetScreen            = QPoint(pointOffsetWorldNormalized.x() * screenRectangle.width(), screenRectangle.height() - pointOffsetWorldNormalized.y() * screenRectangle.height());
+
+            if (!screenRectangle.contains(pointOffsetScreen))
+                continue;
+
+            if (selectionAreaImage.pixelColor(pointOffsetScreen).alpha() > 0)
+                localIndices.push_back(localPointIndex);
+        }
+
+        return localIndices;
+    };
+
+    BENCHMARK("Selection kernel (including the mask)") {
+        const auto selectionMask = SelectionMask(selectionAreaImage, screenRectangle);
+
+        return SelectionKernel(positions, selectionMask, screenProjection).select(spatialIndex);
+    };
+}
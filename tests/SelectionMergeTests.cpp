@@ -0,0 +1,107 @@
+#include "SelectionMerge.h"
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace
+{
+    /** Get numberOfIndices random indices below rangeSize, with duplicates */
+    std::vector<std::uint32_t> getIndices(std::size_t numberOfIndices, std::uint32_t rangeSize, bool sorted, std::uint32_t seed)
+    {
+        std::mt19937 generator(seed);
+
+        std::uniform_int_distribution<std::uint32_t> distribution(0, rangeSize - 1);
+
+        std::vector<std::uint32_t> indices(numberOfIndices);
+
+        for (auto& index : indices)
+            index = distribution(generator);
+
+        for (std::size_t index = 1; index < indices.size(); index += 7)
+            indices[index] = indices[index - 1];
+
+        if (sorted)
+            std::sort(indices.begin(), indices.end());
+
+        return indices;
+    }
+
+    /** Serial reference with set semantics */
+    std::vector<std::uint32_t> mergeSerially(const std::vector<std::uint32_t>& currentIndices, const std::vector<std::uint32_t>& newIndices, SelectionMergeOperation operation)
+    {
+        std::set<std::uint32_t> mergedIndices(currentIndices.begin(), currentIndices.end());
+
+        for (const auto index : newIndices) {
+            if (operation == SelectionMergeOperation::Add)
+                mergedIndices.insert(index);
+            else
+                mergedIndices.erase(index);
+        }
+
+        return { mergedIndices.begin(), mergedIndices.end() };
+    }
+}
+
+TEST_CASE("Both merge strategies match the serial reference on indices with duplicates", "[SelectionMerge]")
+{
+    for (const auto operation : { SelectionMergeOperation::Add, SelectionMergeOperation::Subtract }) {
+        for (const auto sorted : { false, true }) {
+            const auto currentIndices   = getIndices(20'000, 50'000, sorted, 1);
+            const auto newIndices       = getIndices(8'000, 60'000, sorted, 2);
+            const auto expected         = mergeSerially(currentIndices, newIndices, operation);
+
+            REQUIRE(mergeSelectionIndices(currentIndices, newIndices, operation, SelectionMergeStrategy::SortedMerge) == expected);
+            REQUIRE(mergeSelectionIndices(currentIndices, newIndices, operation, SelectionMergeStrategy::Bitset) == expected);
+            REQUIRE(mergeSelectionIndices(currentIndices, newIndices, operation) == expected);
+        }
+    }
+}
+
+TEST_CASE("Subtracting an index removes all of its duplicates", "[SelectionMerge]")
+{
+    const std::vector<std::uint32_t> currentIndices = { 3, 3, 5, 7, 7, 7 };
+    const std::vector<std::uint32_t> newIndices     = { 3, 7 };
+    const std::vector<std::uint32_t> expected       = { 5 };
+
+    REQUIRE(mergeSelectionIndices(currentIndices, newIndices, SelectionMergeOperation::Subtract, SelectionMergeStrategy::SortedMerge) == expected);
+    REQUIRE(mergeSelectionIndices(currentIndices, newIndices, SelectionMergeOperation::Subtract, SelectionMergeStrategy::Bitset) == expected);
+}
+
+TEST_CASE("Merging with empty selections", "[SelectionMerge]")
+{
+    const std::vector<std::uint32_t> indices = { 9, 2, 2, 4 };
+    const std::vector<std::uint32_t> sortedIndices = { 2, 4, 9 };
+
+    for (const auto strategy : { SelectionMergeStrategy::SortedMerge, SelectionMergeStrategy::Bitset }) {
+        REQUIRE(mergeSelectionIndices({}, indices, SelectionMergeOperation::Add, strategy) == sortedIndices);
+        REQUIRE(mergeSelectionIndices(indices, {}, SelectionMergeOperation::Subtract, strategy) == sortedIndices);
+        REQUIRE(mergeSelectionIndices({}, indices, SelectionMergeOperation::Subtract, strategy).empty());
+    }
+}
+
+TEST_CASE("SelectionMerge benchmark", "[.benchmark][SelectionMerge]")
+{
+    const auto currentIndices   = getIndices(5'000'000, 10'000'000, true, 3);
+    const auto newIndices       = getIndices(1'000'000, 10'000'000, false, 4);
+
+    BENCHMARK("Sorted merge (add)") {
+        return mergeSelectionIndices(currentIndices, newIndices, SelectionMergeOperation::Add, SelectionMergeStrategy::SortedMerge);
+    };
+
+    BENCHMARK("Bitset (add)") {
+        return mergeSelectionIndices(currentIndices, newIndices, SelectionMergeOperation::Add, SelectionMergeStrategy::Bitset);
+    };
+
+    BENCHMARK("Sorted merge (subtract)") {
+        return mergeSelectionIndices(currentIndices, newIndices, SelectionMergeOperation::Subtract, SelectionMergeStrategy::SortedMerge);
+    };
+
+    BENCHMARK("Bitset (subtract)") {
+        return mergeSelectionIndices(currentIndices, newIndices, SelectionMergeOperation::Subtract, SelectionMergeStrategy::Bitset);
+    };
+}